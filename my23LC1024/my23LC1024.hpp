@@ -12,9 +12,15 @@
 #define MY23LC1024_H
 #include <pico/time.h>
 #include <hardware/spi.h>
+#include <hardware/pio.h>
+#include <hardware/dma.h>
+#include <hardware/clocks.h>
 
 #include "../myStandardDefines.hpp"
 #include "../myErrorCodes.hpp"
+#include "../myHelpers.hpp"
+#include "../mySPI/mySPI.hpp"
+#include "my23LC1024.pio.h"
 /**
  * @brief Class to use a 23LC1024 spi sram chip.
  * 
@@ -33,12 +39,16 @@ class my23LC1024 {
         /**
          * @brief SDI Communications mode.
          * SDI, like spi, but transfers 2 bits at a time.
+         * @note Runs on a PIO state machine at 20 MHz when miso is the pin after mosi, otherwise
+         * it's bit banged.
          */
         static const uint8_t COMM_MODE_SDI  = 0x01;
         /**
          * @brief SQI Communications mode.
          * SQI, like SDI, but uses 4 bits at a time.
-         * @note In my testing this mode is not stable for large read / write.
+         * @note Runs on a PIO state machine at 20 MHz when mosi, miso, sio2 and hold are
+         * consecutive pins in that order, otherwise it's bit banged. In my testing the bit banged
+         * mode is not stable for large read / write.
          */
         static const uint8_t COMM_MODE_SQI  = 0x02;
         // Valid address Mask, and length:
@@ -52,6 +62,42 @@ class my23LC1024 {
          * 
          */
         static const int32_t LENGTH = MAX_ADDRESS +1; // Set the max length.
+        /**
+         * @brief Hardware SPI clock.
+         * The baud rate requested for hardware SPI, the chip's maximum of 20 MHz.
+         */
+        static const uint32_t HW_SPI_BAUD_RATE = 20000 * 1000;
+        /**
+         * @brief PIO clock.
+         * Highest SCK frequency for SDI and SQI on PIO, the chip's maximum of 20 MHz. The PIO
+         * divider is whole, so the real clock is lower, 15.6 MHz at a 125 MHz system clock.
+         */
+        static const uint32_t PIO_SCK_HZ = 20000 * 1000;
+        /**
+         * @brief Most operations in a batch.
+         */
+        static const uint8_t BATCH_MAX_OPS = MY_23LC1024_BATCH_MAX_OPS;
+        /**
+         * @brief Largest gap read through to join two batch reads.
+         * Shorter than a fresh header and turnaround, so reading and dropping it is cheaper.
+         */
+        static const int32_t BATCH_READ_GAP = 8;
+        // CRC modes:
+        /**
+         * @brief No CRC on buffer transfers.
+         */
+        static const uint8_t CRC_MODE_OFF   = 0x00;
+        /**
+         * @brief CRC-32 on buffer transfers.
+         * IEEE 802.3 polynomial, MSB first, seeded with 0xFFFFFFFF, no final xor. Matches
+         * myHelpers::crc32().
+         */
+        static const uint8_t CRC_MODE_CRC32 = 0x01;
+        /**
+         * @brief CRC-16 on buffer transfers.
+         * CCITT polynomial, MSB first, seeded with 0xFFFF, no final xor. Matches myHelpers::crc16().
+         */
+        static const uint8_t CRC_MODE_CRC16 = 0x02;
         // Error codes:
         /**
          * @brief No error. Value 0
@@ -112,7 +158,28 @@ class my23LC1024 {
          * @brief Comms check failed. Value -310
          * Communications check failed during init.
          */
-        static const int32_t ERROR_COMM_CHECK_FAILED = MY_ERROOR_MY23LC1024_COMM_CHECK_FAILED;   // -310 : Comms check failed during Init.
+        static const int32_t ERROR_COMM_CHECK_FAILED = MY_ERROR_MY23LC1024_COMM_CHECK_FAILED;   // -310 : Comms check failed during Init.
+        /**
+         * @brief Invalid length. Value -311
+         * Length was zero, or longer than the sram.
+         */
+        static const int32_t ERROR_INVALID_LENGTH = MY_ERROR_MY23LC1024_INVALID_LENGTH;         // -311 : Length out of range.
+    /* Types: */
+        /**
+         * @brief One operation of a batch.
+         */
+        struct batchOp_t {
+            int32_t address;        // Address to start at, 0 to MAX_ADDRESS.
+            uint8_t *buffer;        // Data to write, or buffer for data read.
+            int32_t length;         // Number of bytes, must not run past MAX_ADDRESS.
+            bool write;             // True to write, false to read.
+        };
+        /**
+         * @brief Scan callback.
+         * Called with each chunk of a scan, and its sram address. Return true to continue, false to
+         * stop the scan.
+         */
+        typedef bool (*scanCallback_t)(const int32_t address, const uint8_t *buffer, const int32_t length, void *userData);
 
     /* Constructor: */
     // HW SPI Constructors:
@@ -302,6 +369,111 @@ class my23LC1024 {
          * @return int32_t returns 0 (NO_ERROR) for okay, negative for error code.
          */
         int32_t         stop();                                                     // stop the read / write process. returns 0 for okay, negative for error code.
+        /**
+         * @brief Read a buffer from sram.
+         * Reads length bytes starting at address in one sequential burst, with chip select held for
+         * the whole transfer. On hardware SPI the data is read by DMA. Reads past the end of the sram
+         * wrap to address 0. The sram must be idle.
+         * @param address Address to start reading from, negative addresses count from the end.
+         * @param buffer Buffer for the data.
+         * @param length Number of bytes to read, 1 to LENGTH.
+         * @return int32_t Returns the number of bytes read, negative for error code.
+         */
+        int32_t         readBuffer(const int32_t address, uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Write a buffer to sram.
+         * Writes length bytes starting at address in one sequential burst, with chip select held for
+         * the whole transfer. On hardware SPI the data is sent by DMA. Writes past the end of the sram
+         * wrap to address 0. The sram must be idle.
+         * @param address Address to start writing to, negative addresses count from the end.
+         * @param buffer Data to write.
+         * @param length Number of bytes to write, 1 to LENGTH.
+         * @return int32_t Returns the number of bytes written, negative for error code.
+         */
+        int32_t         writeBuffer(const int32_t address, const uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Start reading a buffer from sram.
+         * As readBuffer, but returns once the transfer is running, so other work, or transfers on
+         * other buses, can overlap it. Where the transfer can't run by DMA it completes before
+         * returning. The sram stays busy until waitBuffer().
+         * @param address Address to start reading from, negative addresses count from the end.
+         * @param buffer Buffer for the data, filled by waitBuffer().
+         * @param length Number of bytes to read, 1 to LENGTH.
+         * @return int32_t Returns 0 (NO_ERROR) if started, negative for error code.
+         */
+        int32_t         startReadBuffer(const int32_t address, uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Start writing a buffer to sram.
+         * As writeBuffer, but returns once the transfer is running. buffer must stay valid until
+         * waitBuffer().
+         * @param address Address to start writing to, negative addresses count from the end.
+         * @param buffer Data to write.
+         * @param length Number of bytes to write, 1 to LENGTH.
+         * @return int32_t Returns 0 (NO_ERROR) if started, negative for error code.
+         */
+        int32_t         startWriteBuffer(const int32_t address, const uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Check if a started buffer transfer is still running.
+         * @return true The transfer is running.
+         * @return false The transfer is done, or none was started. Call waitBuffer() to finish it.
+         */
+        bool            isBufferBusy();
+        /**
+         * @brief Finish a started buffer transfer.
+         * Waits for the transfer to complete and ends it, leaving the sram idle.
+         * @return int32_t Returns the number of bytes transferred, negative for error code.
+         */
+        int32_t         waitBuffer();
+        /**
+         * @brief Check if another sram is on the same bus.
+         * Srams on the same SPI port, or sharing a clock pin, can't transfer at the same time.
+         * @param other Sram to compare with.
+         * @return true Both srams share a bus.
+         * @return false The srams are on separate buses.
+         */
+        bool            sharesBus(const my23LC1024 &other);
+        /**
+         * @brief Run a batch of scattered reads and writes.
+         * Runs all the writes, then all the reads, each in address order. Operations that follow on
+         * from each other share one chip select window and header, and reads up to BATCH_READ_GAP
+         * bytes apart are joined by reading through the gap. Reads see the batch's writes. Writes
+         * that overlap each other are refused with ERROR_INVAID_ADDRESS. The sram must be idle.
+         * @param ops Operations to run.
+         * @param count Number of operations, 1 to BATCH_MAX_OPS.
+         * @return int32_t Returns the number of bytes transferred, negative for error code.
+         */
+        int32_t         transferBatch(const batchOp_t *ops, const uint8_t count);
+        /**
+         * @brief Stream a range of sram through a callback.
+         * Reads the range in one sequential read, chunkSize bytes at a time, into two alternating
+         * halves of buffers. The callback runs on each chunk while the next is read by DMA, so
+         * processing overlaps the bus. The sram must be idle.
+         * @param address Address to start at, negative addresses count from the end.
+         * @param length Number of bytes to scan, 1 to LENGTH. Wraps past the end of the sram.
+         * @param buffers Buffer of 2 * chunkSize bytes.
+         * @param chunkSize Bytes per chunk.
+         * @param callback Called with each chunk, return false to stop the scan.
+         * @param userData Passed to the callback.
+         * @return int32_t Returns the number of bytes scanned, negative for error code.
+         */
+        int32_t         scan(const int32_t address, const int32_t length, uint8_t *buffers, const int32_t chunkSize,
+                                scanCallback_t callback, void *userData=nullptr);
+        /**
+         * @brief Set the CRC mode for buffer transfers.
+         * With a CRC mode set, readBuffer, writeBuffer, their start / wait forms, and scan, take a
+         * CRC of the data moved, read back with getCrc(). Transfers by DMA have it taken by the DMA
+         * sniffer at no CPU cost, others in software. The sniffer is shared by all DMA channels, so
+         * nothing else may use it while a transfer runs.
+         * @param mode CRC_MODE_OFF, CRC_MODE_CRC32, or CRC_MODE_CRC16. Others turn it off.
+         */
+        void            setCrcMode(const uint8_t mode);
+        /**
+         * @brief Get the CRC of the last buffer transfer.
+         * A scan's CRC covers the bytes it returns as scanned, not a chunk read ahead and dropped
+         * when the callback stopped it.
+         * @return uint32_t CRC of the data of the last buffer transfer or scan, 0 with CRC off.
+         */
+        uint32_t        getCrc();
 
     private:
     /* Constants: */
@@ -346,6 +518,25 @@ class my23LC1024 {
         uint8_t _status = 0x00;     // the status byte. Packed uint8.
         int32_t _nextIndex = -1;  // The next address to read / write.
         int32_t _lastIndex = -1;  // The last address read / written.
+        int16_t _profileId = -1;  // mySPI profile when using hw spi.
+        PIO     _pio = nullptr;     // PIO block running SDI / SQI, nullptr when bit banged.
+        int     _pioSm = -1;        // PIO state machine, -1 when bit banged.
+        uint    _pioOffset = 0;     // Program offset in the PIO instruction memory.
+        const pio_program_t *_pioProgram = nullptr;
+        int     _pioTxChannel = -1; // DMA channels feeding the state machine.
+        int     _pioRxChannel = -1;
+        uint8_t _pending = 0;       // How the started buffer transfer is running, PENDING_*.
+        int32_t _pendingLength = 0; // Length of the started buffer transfer.
+        int     _sniffChannel = -1; // DMA channel the sniffer is on, -1 for none.
+        uint8_t _crcMode = CRC_MODE_OFF;
+        uint32_t _crc = 0;          // CRC of the data moved so far.
+    /* Constants: */
+        static const int32_t PIO_DMA_THRESHOLD = 8; // Shorter PIO transfers skip DMA.
+        static const uint8_t PENDING_NONE       = 0; // No buffer transfer started.
+        static const uint8_t PENDING_DONE       = 1; // Buffer transfer completed when started.
+        static const uint8_t PENDING_SPI        = 2; // Buffer transfer running on mySPI DMA.
+        static const uint8_t PENDING_PIO_READ   = 3; // Buffer read running on PIO DMA.
+        static const uint8_t PENDING_PIO_WRITE  = 4; // Buffer write running on PIO DMA.
         // uint8_t _lastState;         // The last reading or writing state. for mimicing hold.
 
     /* Functions: */
@@ -353,6 +544,7 @@ class my23LC1024 {
         void inline __deselectChip__();                                             // raise the cs line.
         void inline __incrementIndex__();                                         // Increment the stored address, wrapping at max address.
         void inline __setNextIndex__(int32_t value);                              // Set the address we're working on.
+        void inline __advanceIndex__(const int32_t count);                         // Advance the stored address by count, wrapping at max address.
         uint8_t inline __getState__();                                              // return the state bits from the status byte.
         void inline __setStateIdle__();                                             // Set the state bits in the status byte to idle.
         void inline __setStateRead__();                                             // Set the state bits in the status byte to reading.
@@ -363,6 +555,19 @@ class my23LC1024 {
         void inline __setSDIPinModes__(const bool isOutput);                        // Set the pin modes for bit banged SDI.
         void inline __setSQIPinModes__(const bool isOutput);                        // Set the pin modes for bit banged SQI.
         void        __resetComms__();                                               // Reset the comms mode to SPI.
+        bool        __pioInit__();                                                  // Start SDI / SQI on PIO, false if the pins, PIO or DMA aren't available.
+        void        __pioDeinit__();                                                // Release the PIO state machine and DMA channels.
+        int32_t     __PIORead__(uint8_t *buffer, const int32_t length);             // SDI / SQI read on PIO.
+        int32_t     __PIOWrite__(const uint8_t *buffer, const int32_t length);      // SDI / SQI write on PIO.
+        void        __PIOStartRead__(uint8_t *buffer, const int32_t length);        // Start a PIO read by DMA.
+        void        __PIOStartWrite__(const uint8_t *buffer, const int32_t length); // Start a PIO write by DMA.
+        void        __PIOWaitWrite__();                                             // Wait for a PIO write to leave the pins.
+        void        __startPendingRead__(uint8_t *buffer, const int32_t length);    // Start reading into buffer, by DMA where possible.
+        void        __startPendingWrite__(const uint8_t *buffer, const int32_t length); // Start writing from buffer, by DMA where possible.
+        void        __waitPending__();                                              // Wait for the transfer started, if any.
+        void        __crcStart__();                                                 // Seed the CRC for a buffer transfer.
+        void        __crcSniff__(const int channel);                                // Point the sniffer at a DMA transfer about to start.
+        void        __crcUpdate__(const uint8_t *buffer, const int32_t length);     // Take the CRC in software.
         int32_t    __HWSPIRead__(uint8_t *buffer, const int32_t length);            // Use hw spi to read.
         int32_t    __HWSPIWrite__(const uint8_t *buffer, const int32_t length);     // Use hw spi to write.
         int32_t     __SPIRead__(uint8_t *buffer, const int32_t length);             // Bit banged SPI read.
@@ -393,7 +598,8 @@ int32_t my23LC1024::initialize(const uint8_t commsMode) {
         if (_holdPin == MY_NOT_A_PIN) { return ERROR_HOLD_NOT_DEFINED; } 
         if (_sio2Pin == MY_NOT_A_PIN) { return ERROR_SIO2_NOT_DEFINED; }
     }
-// Initialize pins as GPIO for now.
+// Release PIO from a previous initialize, and initialize pins as GPIO for now.
+    __pioDeinit__();
     gpio_init(_csPin);
     gpio_init(_sckPin);
     gpio_init(_misoPin);
@@ -423,10 +629,23 @@ int32_t my23LC1024::initialize(const uint8_t commsMode) {
     __resetComms__();
     // __breakpoint();
     if (_useHWSPI == true) {
-        spi_init(_spiPort, 1000*20000); // init spi at 20 Mhz.
-        gpio_set_function(_sckPin,  GPIO_FUNC_SPI); // set sck as spi.
-        gpio_set_function(_misoPin, GPIO_FUNC_SPI); // set miso as spi.
-        gpio_set_function(_mosiPin, GPIO_FUNC_SPI); // set mosi as spi.
+        // Share the port if another device has already initialized it.
+        if (mySPI::getPortInit(_spiPort) == false) {
+            int32_t returnValue = mySPI::initializeMaster(_spiPort, _sckPin, _misoPin, _mosiPin, HW_SPI_BAUD_RATE);
+            if (returnValue < 0) { return returnValue; }
+        } else {
+            gpio_set_function(_sckPin,  GPIO_FUNC_SPI); // set sck as spi.
+            gpio_set_function(_misoPin, GPIO_FUNC_SPI); // set miso as spi.
+            gpio_set_function(_mosiPin, GPIO_FUNC_SPI); // set mosi as spi.
+        }
+        if (_profileId < 0) {
+            mySPI::profile_t profile;
+            profile.baudRate = HW_SPI_BAUD_RATE;
+            profile.csPin = _csPin;
+            int32_t returnValue = mySPI::registerProfile(_spiPort, profile);
+            if (returnValue < 0) { return returnValue; }
+            _profileId = (int16_t)returnValue;
+        }
     } else {
         uint8_t instruction;
         switch (_commsMode) {
@@ -439,7 +658,7 @@ int32_t my23LC1024::initialize(const uint8_t commsMode) {
                 instruction = EDIO_INSTRUCTION;
                 __SPIWrite__(&instruction, 1);
                 __deselectChip__();
-                __setSDIPinModes__(true);
+                if (__pioInit__() == false) { __setSDIPinModes__(true); }
                 break;
             case COMM_MODE_SQI:
                 __setSPIPinModes__();
@@ -447,7 +666,7 @@ int32_t my23LC1024::initialize(const uint8_t commsMode) {
                 instruction = EQIO_INSTRUCTION;
                 __SPIWrite__(&instruction, 1);
                 __deselectChip__();
-                __setSQIPinModes__(true);
+                if (__pioInit__() == false) { __setSQIPinModes__(true); }
                 break;    
         }
     }
@@ -636,10 +855,171 @@ int32_t my23LC1024::stop() {
     _nextIndex = -1;
     return NO_ERROR;
 }
+int32_t my23LC1024::readBuffer(const int32_t address, uint8_t *buffer, const int32_t length) {
+    int32_t returnValue = startReadBuffer(address, buffer, length);
+    if (returnValue < 0) { return returnValue; }
+    return waitBuffer();
+}
+
+int32_t my23LC1024::writeBuffer(const int32_t address, const uint8_t *buffer, const int32_t length) {
+    int32_t returnValue = startWriteBuffer(address, buffer, length);
+    if (returnValue < 0) { return returnValue; }
+    return waitBuffer();
+}
+
+int32_t my23LC1024::startReadBuffer(const int32_t address, uint8_t *buffer, const int32_t length) {
+    if (length < 1 or length > LENGTH) { return ERROR_INVALID_LENGTH; }
+    int32_t returnValue = startRead(address);
+    if (returnValue < 0) { return returnValue; }
+    _pendingLength = length;
+    __crcStart__();
+    __startPendingRead__(buffer, length);
+    return NO_ERROR;
+}
+
+int32_t my23LC1024::startWriteBuffer(const int32_t address, const uint8_t *buffer, const int32_t length) {
+    if (length < 1 or length > LENGTH) { return ERROR_INVALID_LENGTH; }
+    int32_t returnValue = startWrite(address);
+    if (returnValue < 0) { return returnValue; }
+    _pendingLength = length;
+    __crcStart__();
+    __startPendingWrite__(buffer, length);
+    return NO_ERROR;
+}
+
+bool my23LC1024::isBufferBusy() {
+    switch (_pending) {
+        case PENDING_SPI:
+            return mySPI::dma_is_busy(_spiPort);
+        case PENDING_PIO_READ:
+            return dma_channel_is_busy(_pioRxChannel);
+        case PENDING_PIO_WRITE:
+            return dma_channel_is_busy(_pioTxChannel) or pio_sm_is_tx_fifo_empty(_pio, _pioSm) == false;
+    }
+    return false;
+}
+
+int32_t my23LC1024::waitBuffer() {
+    if (_pending == PENDING_NONE) { return ERROR_SRAM_IDLE; }
+    __waitPending__();
+    __advanceIndex__(_pendingLength);
+    stop();
+    return _pendingLength;
+}
+
+int32_t my23LC1024::scan(const int32_t address, const int32_t length, uint8_t *buffers, const int32_t chunkSize,
+                            scanCallback_t callback, void *userData) {
+    if (length < 1 or length > LENGTH or chunkSize < 1) { return ERROR_INVALID_LENGTH; }
+    int32_t returnValue = startRead(address);
+    if (returnValue < 0) { return returnValue; }
+    const int32_t start = _nextIndex;
+    __crcStart__();
+// Keep the next chunk in flight while the callback runs on the last one, all in one read:
+    uint8_t *chunks[2] = { buffers, &buffers[chunkSize] };
+    uint8_t current = 0;
+    int32_t done = 0;
+    int32_t nextLength = MIN(chunkSize, length);
+    uint32_t crcDone;
+    __startPendingRead__(chunks[current], nextLength);
+    while (true) {
+        __waitPending__();
+        crcDone = _crc;     // CRC of the chunks read so far, before the next one starts.
+        const int32_t readLength = nextLength;
+        const int32_t nextOffset = done + readLength;
+        if (nextOffset < length) {
+            nextLength = MIN(chunkSize, length - nextOffset);
+            __startPendingRead__(chunks[current ^ 1], nextLength);
+        }
+        const bool more = callback((start + done) & MAX_ADDRESS, chunks[current], readLength, userData);
+        done = nextOffset;
+        if (more == false or done == length) { break; }
+        current ^= 1;
+    }
+    __waitPending__();      // A chunk may still be in flight if the callback stopped early.
+    _crc = crcDone;         // Which isn't counted in done, so drop it from the CRC.
+    __advanceIndex__(done);
+    stop();
+    return done;
+}
+
+int32_t my23LC1024::transferBatch(const batchOp_t *ops, const uint8_t count) {
+// Do checks:
+    if (count < 1 or count > BATCH_MAX_OPS) { return ERROR_INVALID_LENGTH; }
+    for (uint8_t i=0; i<count; i++) {
+        if (ops[i].address < 0 or ops[i].address > MAX_ADDRESS) { return ERROR_INVAID_ADDRESS; }
+        if (ops[i].length < 1 or ops[i].length > LENGTH - ops[i].address) { return ERROR_INVALID_LENGTH; }
+    // Overlapping writes would land in sorted order, not the caller's:
+        if (ops[i].write == false) { continue; }
+        for (uint8_t j=0; j<i; j++) {
+            if (ops[j].write == false) { continue; }
+            if (ops[i].address < ops[j].address + ops[j].length and ops[j].address < ops[i].address + ops[i].length) {
+                return ERROR_INVAID_ADDRESS;
+            }
+        }
+    }
+    if (isHeld() == true) { return ERROR_SRAM_HELD; }
+    if (isBusy() == true) { return ERROR_SRAM_BUSY; }
+// Sort, writes first, then by address:
+    uint8_t order[BATCH_MAX_OPS];
+    for (uint8_t i=0; i<count; i++) {
+        uint8_t j = i;
+        while (j > 0) {
+            const batchOp_t &previous = ops[order[j-1]];
+            if (previous.write > ops[i].write) { break; }
+            if (previous.write == ops[i].write and previous.address <= ops[i].address) { break; }
+            order[j] = order[j-1];
+            j--;
+        }
+        order[j] = i;
+    }
+// Run each window:
+    uint8_t gapBuffer[BATCH_READ_GAP];
+    int32_t total = 0;
+    uint8_t i = 0;
+    while (i < count) {
+        const batchOp_t &first = ops[order[i]];
+        int32_t returnValue = (first.write == true) ? startWrite(first.address) : startRead(first.address);
+        if (returnValue < 0) { return returnValue; }
+        int32_t end = first.address;
+        while (i < count) {
+            const batchOp_t &op = ops[order[i]];
+            const int32_t gap = op.address - end;
+            if (op.write != first.write or gap < 0) { break; }
+            if (gap > ((op.write == true) ? 0 : BATCH_READ_GAP)) { break; }
+            if (op.write == true) {
+                __writeBuffer__(op.buffer, op.length);
+            } else {
+                if (gap > 0) { __readBuffer__(gapBuffer, gap); }
+                __readBuffer__(op.buffer, op.length);
+            }
+            end = op.address + op.length;
+            total += op.length;
+            i++;
+        }
+        __advanceIndex__(end - first.address);
+        stop();
+    }
+    return total;
+}
+
+void my23LC1024::setCrcMode(const uint8_t mode) {
+    _crcMode = (mode == CRC_MODE_CRC32 or mode == CRC_MODE_CRC16) ? mode : CRC_MODE_OFF;
+    _crc = 0;
+}
+
+uint32_t my23LC1024::getCrc() {
+    return _crc;
+}
+
+bool my23LC1024::sharesBus(const my23LC1024 &other) {
+    if (_useHWSPI == true and other._useHWSPI == true) { return _spiPort == other._spiPort; }
+    return _sckPin == other._sckPin;
+}
 /*********************************************************************
  * Private functions:
  *********************************************************************/
 void inline my23LC1024::__selectChip__() {
+    if (_useHWSPI == true) { mySPI::selectProfile(_spiPort, _profileId); }
     gpio_put(_csPin, false);
 }
 
@@ -657,6 +1037,12 @@ void inline my23LC1024::__incrementIndex__() {
     if (_nextIndex > MAX_ADDRESS) { _nextIndex = 0; }
 }
 
+void inline my23LC1024::__advanceIndex__(const int32_t count) {
+    if (count < 1) { return; }
+    _lastIndex = (_nextIndex + count - 1) % LENGTH;
+    _nextIndex = (_nextIndex + count) % LENGTH;
+}
+
 uint8_t inline my23LC1024::__getState__() {
     return (_status & STATUS_STATE_MASK);
 }
@@ -745,6 +1131,220 @@ void inline my23LC1024::__setSQIPinModes__(const bool isOutput) {
     }
 }
 
+bool my23LC1024::__pioInit__() {
+    const pio_program_t *program;
+    uint8_t width;
+// PIO needs the data pins consecutive, sio0 first:
+    if (_commsMode == COMM_MODE_SDI) {
+        if (_misoPin != _mosiPin + 1) { return false; }
+        program = &my23LC1024_sdi_program;
+        width = 2;
+    } else {
+        if (_misoPin != _mosiPin + 1 or _sio2Pin != _mosiPin + 2 or _holdPin != _mosiPin + 3) { return false; }
+        program = &my23LC1024_sqi_program;
+        width = 4;
+    }
+// Find a PIO block with room:
+    PIO pios[2] = { pio0, pio1 };
+    for (uint8_t i=0; i<2; i++) {
+        if (pio_can_add_program(pios[i], program) == false) { continue; }
+        int sm = pio_claim_unused_sm(pios[i], false);
+        if (sm < 0) { continue; }
+        _pio = pios[i];
+        _pioSm = sm;
+        break;
+    }
+    if (_pioSm < 0) { return false; }
+    _pioProgram = program;
+    _pioOffset = pio_add_program(_pio, program);
+// Without a pair of DMA channels, give it all back and bit bang:
+    _pioTxChannel = dma_claim_unused_channel(false);
+    _pioRxChannel = dma_claim_unused_channel(false);
+    if (_pioTxChannel < 0 or _pioRxChannel < 0) {
+        if (_pioTxChannel >= 0) { dma_channel_unclaim(_pioTxChannel); }
+        if (_pioRxChannel >= 0) { dma_channel_unclaim(_pioRxChannel); }
+        pio_remove_program(_pio, program, _pioOffset);
+        pio_sm_unclaim(_pio, _pioSm);
+        _pio = nullptr;
+        _pioSm = -1;
+        _pioTxChannel = -1;
+        _pioRxChannel = -1;
+        return false;
+    }
+// Configure the state machine:
+    pio_sm_config config = (width == 2) ? my23LC1024_sdi_program_get_default_config(_pioOffset)
+                                        : my23LC1024_sqi_program_get_default_config(_pioOffset);
+    sm_config_set_out_pins(&config, _mosiPin, width);
+    sm_config_set_set_pins(&config, _mosiPin, width);
+    sm_config_set_in_pins(&config, _mosiPin);
+    sm_config_set_sideset_pins(&config, _sckPin);
+    sm_config_set_out_shift(&config, false, true, 8);   // MSB first, autopull every byte.
+    sm_config_set_in_shift(&config, false, true, 8);    // MSB first, autopush every byte.
+// 4 cycles per clock. Round the divider up, a fractional one jitters the SCK phases below 25ns:
+    const uint32_t clockDiv = (clock_get_hz(clk_sys) + (4 * PIO_SCK_HZ) - 1) / (4 * PIO_SCK_HZ);
+    sm_config_set_clkdiv_int_frac(&config, (uint16_t)MAX(clockDiv, 1u), 0);
+// Hand the pins to PIO, SCK low:
+    pio_gpio_init(_pio, _sckPin);
+    for (uint8_t i=0; i<width; i++) { pio_gpio_init(_pio, _mosiPin + i); }
+    pio_sm_set_pins_with_mask(_pio, _pioSm, 0, 1u << _sckPin);
+    pio_sm_set_consecutive_pindirs(_pio, _pioSm, _sckPin, 1, true);
+    pio_sm_set_consecutive_pindirs(_pio, _pioSm, _mosiPin, width, false);
+    pio_sm_init(_pio, _pioSm, _pioOffset, &config);
+    pio_sm_set_enabled(_pio, _pioSm, true);
+    return true;
+}
+
+void my23LC1024::__pioDeinit__() {
+    if (_pioSm < 0) { return; }
+    pio_sm_set_enabled(_pio, _pioSm, false);
+    pio_remove_program(_pio, _pioProgram, _pioOffset);
+    pio_sm_unclaim(_pio, _pioSm);
+    dma_channel_unclaim(_pioTxChannel);
+    dma_channel_unclaim(_pioRxChannel);
+    _pio = nullptr;
+    _pioSm = -1;
+    _pioTxChannel = -1;
+    _pioRxChannel = -1;
+}
+
+int32_t my23LC1024::__PIORead__(uint8_t *buffer, const int32_t length) {
+    const uint32_t clocksPerByte = (_commsMode == COMM_MODE_SDI) ? 4 : 2;
+    if (length < PIO_DMA_THRESHOLD) {
+        pio_sm_put_blocking(_pio, _pioSm, 0);                                   // Clocks to write.
+        pio_sm_put_blocking(_pio, _pioSm, (uint32_t)length * clocksPerByte);    // Clocks to read.
+        for (int32_t i=0; i<length; i++) { buffer[i] = (uint8_t)pio_sm_get_blocking(_pio, _pioSm); }
+        return length;
+    }
+    __PIOStartRead__(buffer, length);
+    dma_channel_wait_for_finish_blocking(_pioRxChannel);
+    return length;
+}
+
+void my23LC1024::__PIOStartRead__(uint8_t *buffer, const int32_t length) {
+    const uint32_t clocksPerByte = (_commsMode == COMM_MODE_SDI) ? 4 : 2;
+    dma_channel_config rxConfig = dma_channel_get_default_config(_pioRxChannel);
+    channel_config_set_transfer_data_size(&rxConfig, DMA_SIZE_8);     // Low byte of the FIFO.
+    channel_config_set_read_increment(&rxConfig, false);
+    channel_config_set_write_increment(&rxConfig, true);
+    channel_config_set_dreq(&rxConfig, pio_get_dreq(_pio, _pioSm, false));
+    channel_config_set_sniff_enable(&rxConfig, true);
+    dma_channel_configure(_pioRxChannel, &rxConfig, buffer, &_pio->rxf[_pioSm], length, true);
+    pio_sm_put_blocking(_pio, _pioSm, 0);                                   // Clocks to write.
+    pio_sm_put_blocking(_pio, _pioSm, (uint32_t)length * clocksPerByte);    // Clocks to read.
+}
+
+void my23LC1024::__startPendingRead__(uint8_t *buffer, const int32_t length) {
+    if (_useHWSPI == true and length >= mySPI::DMA_MIN_LENGTH) {
+        __crcSniff__(mySPI::get_dma_channel(_spiPort, false));
+        mySPI::read_dma_start(_spiPort, 0x00, buffer, length);
+        _pending = PENDING_SPI;
+    } else if (_pioSm >= 0 and length >= PIO_DMA_THRESHOLD) {
+        __crcSniff__(_pioRxChannel);
+        __PIOStartRead__(buffer, length);
+        _pending = PENDING_PIO_READ;
+    } else {
+        __readBuffer__(buffer, length);
+        __crcUpdate__(buffer, length);
+        _pending = PENDING_DONE;
+    }
+}
+
+void my23LC1024::__startPendingWrite__(const uint8_t *buffer, const int32_t length) {
+    if (_useHWSPI == true and length >= mySPI::DMA_MIN_LENGTH) {
+        __crcSniff__(mySPI::get_dma_channel(_spiPort, true));
+        mySPI::write_dma_start(_spiPort, buffer, length);
+        _pending = PENDING_SPI;
+    } else if (_pioSm >= 0 and length >= PIO_DMA_THRESHOLD) {
+        __crcSniff__(_pioTxChannel);
+        __PIOStartWrite__(buffer, length);
+        _pending = PENDING_PIO_WRITE;
+    } else {
+        __writeBuffer__(buffer, length);
+        __crcUpdate__(buffer, length);
+        _pending = PENDING_DONE;
+    }
+}
+
+void my23LC1024::__crcStart__() {
+    if (_crcMode == CRC_MODE_CRC32) {
+        _crc = 0xFFFFFFFF;
+    } else if (_crcMode == CRC_MODE_CRC16) {
+        _crc = 0xFFFF;
+    }
+}
+
+void my23LC1024::__crcSniff__(const int channel) {
+    if (_crcMode == CRC_MODE_OFF) { return; }
+    const uint calc = (_crcMode == CRC_MODE_CRC32) ? DMA_SNIFF_CTRL_CALC_VALUE_CRC32 : DMA_SNIFF_CTRL_CALC_VALUE_CRC16;
+    dma_sniffer_set_data_accumulator(_crc);
+    dma_sniffer_enable(channel, calc, false);      // Sniffing is enabled in the channel's config.
+    _sniffChannel = channel;
+}
+
+void my23LC1024::__crcUpdate__(const uint8_t *buffer, const int32_t length) {
+    if (_crcMode == CRC_MODE_CRC32) {
+        _crc = myHelpers::crc32(buffer, length, _crc);
+    } else if (_crcMode == CRC_MODE_CRC16) {
+        _crc = myHelpers::crc16(buffer, length, (uint16_t)_crc);
+    }
+}
+
+void my23LC1024::__waitPending__() {
+    switch (_pending) {
+        case PENDING_SPI:
+            mySPI::dma_wait(_spiPort);
+            break;
+        case PENDING_PIO_READ:
+            dma_channel_wait_for_finish_blocking(_pioRxChannel);
+            break;
+        case PENDING_PIO_WRITE:
+            __PIOWaitWrite__();
+            break;
+    }
+    _pending = PENDING_NONE;
+    if (_sniffChannel >= 0) {
+        _crc = dma_sniffer_get_data_accumulator();
+        dma_sniffer_disable();
+        _sniffChannel = -1;
+    }
+}
+
+int32_t my23LC1024::__PIOWrite__(const uint8_t *buffer, const int32_t length) {
+    const uint32_t clocksPerByte = (_commsMode == COMM_MODE_SDI) ? 4 : 2;
+    if (length >= PIO_DMA_THRESHOLD) {
+        __PIOStartWrite__(buffer, length);
+        __PIOWaitWrite__();
+        return length;
+    }
+    pio_sm_put_blocking(_pio, _pioSm, (uint32_t)length * clocksPerByte);    // Clocks to write.
+    pio_sm_put_blocking(_pio, _pioSm, 0);                                   // Clocks to read.
+    for (int32_t i=0; i<length; i++) { pio_sm_put_blocking(_pio, _pioSm, (uint32_t)buffer[i] << 24); }
+    __PIOWaitWrite__();
+    return length;
+}
+
+void my23LC1024::__PIOStartWrite__(const uint8_t *buffer, const int32_t length) {
+    const uint32_t clocksPerByte = (_commsMode == COMM_MODE_SDI) ? 4 : 2;
+    pio_sm_put_blocking(_pio, _pioSm, (uint32_t)length * clocksPerByte);    // Clocks to write.
+    pio_sm_put_blocking(_pio, _pioSm, 0);                                   // Clocks to read.
+// Byte writes to the FIFO are replicated across the word, so land in the top byte:
+    dma_channel_config txConfig = dma_channel_get_default_config(_pioTxChannel);
+    channel_config_set_transfer_data_size(&txConfig, DMA_SIZE_8);
+    channel_config_set_read_increment(&txConfig, true);
+    channel_config_set_write_increment(&txConfig, false);
+    channel_config_set_dreq(&txConfig, pio_get_dreq(_pio, _pioSm, true));
+    channel_config_set_sniff_enable(&txConfig, true);
+    dma_channel_configure(_pioTxChannel, &txConfig, &_pio->txf[_pioSm], buffer, length, true);
+}
+
+void my23LC1024::__PIOWaitWrite__() {
+    dma_channel_wait_for_finish_blocking(_pioTxChannel);
+// Wait for the state machine to shift the last byte out, and stall on the next command:
+    const uint32_t stallMask = 1u << (PIO_FDEBUG_TXSTALL_LSB + _pioSm);
+    _pio->fdebug = stallMask;
+    while ((_pio->fdebug & stallMask) == 0) { tight_loop_contents(); }
+}
+
 void my23LC1024::__resetComms__() {
     gpio_put(_mosiPin, true);           // Set mosi high
     gpio_set_dir(_misoPin, GPIO_OUT);    // set Miso output
@@ -787,11 +1387,11 @@ void my23LC1024::__resetComms__() {
 }
 
 int32_t my23LC1024::__HWSPIRead__(uint8_t *buffer, const int32_t length) {
-    return spi_read_blocking(_spiPort, 0x00, buffer, length);
+    return mySPI::read_dma_blocking(_spiPort, 0x00, buffer, length);
 }
 
 int32_t my23LC1024::__HWSPIWrite__(const uint8_t *buffer, const int32_t length) {
-    return spi_write_blocking(_spiPort, buffer, length);
+    return mySPI::write_dma_blocking(_spiPort, buffer, length);
 }
 
 int32_t my23LC1024::__SPIRead__(uint8_t *buffer, const int32_t length) {
@@ -836,6 +1436,7 @@ int32_t my23LC1024::__SPIWrite__(const uint8_t *buffer, const int32_t length) {
 }
 
 int32_t my23LC1024::__SDIRead__(uint8_t *buffer, const int32_t length) {
+    if (_pioSm >= 0) { return __PIORead__(buffer, length); }
 // Set the variables:    
     int32_t bytesRead = 0;
     const uint8_t sio0 = _mosiPin;
@@ -864,6 +1465,7 @@ int32_t my23LC1024::__SDIRead__(uint8_t *buffer, const int32_t length) {
 }
 
 int32_t my23LC1024::__SDIWrite__(const uint8_t *buffer, const int32_t length) {
+    if (_pioSm >= 0) { return __PIOWrite__(buffer, length); }
 // Set variables:
     // __breakpoint();
     int32_t bytesSent = 0;
@@ -890,6 +1492,7 @@ int32_t my23LC1024::__SDIWrite__(const uint8_t *buffer, const int32_t length) {
 }
 
 int32_t my23LC1024::__SQIRead__(uint8_t *buffer, const int32_t length) {
+    if (_pioSm >= 0) { return __PIORead__(buffer, length); }
     const uint8_t sio0 = _mosiPin;
     const uint8_t sio1 = _misoPin;
     const uint8_t sio2 = _sio2Pin;
@@ -935,6 +1538,7 @@ int32_t my23LC1024::__SQIRead__(uint8_t *buffer, const int32_t length) {
 }
 
 int32_t my23LC1024::__SQIWrite__(const uint8_t *buffer, const int32_t length) {
+    if (_pioSm >= 0) { return __PIOWrite__(buffer, length); }
     const uint8_t sio0 = _mosiPin;
     const uint8_t sio1 = _misoPin;
     const uint8_t sio2 = _sio2Pin;
@@ -0,0 +1,181 @@
+/**
+ * @file my23LC1024Array.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Striped array of 23LC1024 srams.
+ * @version 0.1
+ * @date 2022-08-09
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY23LC1024_ARRAY_H
+#define MY23LC1024_ARRAY_H
+
+#include "../myStandardDefines.hpp"
+#include "../myErrorCodes.hpp"
+#include "my23LC1024.hpp"
+/**
+ * @brief Striped array of 23LC1024 srams.
+ * Joins up to MY_23LC1024_ARRAY_MAX_CHIPS srams into one address space of 128KB per chip. The
+ * space is cut into stripes, dealt round robin across the chips, so a long transfer touches every
+ * chip. Each stripe is started without waiting, so stripes on chips with their own bus (SPI port,
+ * or PIO pins) run at the same time; chips sharing a bus take turns.
+ * @note Chips must be initialized first, and used only through the array.
+ */
+class my23LC1024Array {
+
+    public:
+/* ################### Constants: ################# */
+        /**
+         * @brief Most chips in an array.
+         */
+        static const uint8_t MAX_CHIPS = MY_23LC1024_ARRAY_MAX_CHIPS;
+        static_assert(MAX_CHIPS >= 1 and MAX_CHIPS <= 8, "MY_23LC1024_ARRAY_MAX_CHIPS must be 1 to 8, chips are tracked in 8 bit masks.");
+    // Error codes:
+        /**
+         * @brief No error. Value 0.
+         */
+        static const int32_t NO_ERROR = MY_NO_ERROR;
+        /**
+         * @brief Invalid address. Value -301.
+         * The address is negative or past the end of the array.
+         */
+        static const int32_t ERROR_INVALID_ADDRESS = MY_ERROR_MY23LC1024_INVALID_ADDRESS;
+        /**
+         * @brief Invalid length. Value -311.
+         * The length is zero, or runs past the end of the array.
+         */
+        static const int32_t ERROR_INVALID_LENGTH = MY_ERROR_MY23LC1024_INVALID_LENGTH;
+/* ################## Constructor: ################ */
+        /**
+         * @brief Construct a new my23LC1024Array object.
+         * @param srams Initialized srams, in address order.
+         * @param numChips Number of srams, 1 to MAX_CHIPS, extra chips are ignored.
+         * @param stripeSize Bytes per stripe, rounded down to a power of two from 32 to 128KB.
+         * Defaults to MY_23LC1024_STRIPE_SIZE.
+         */
+        my23LC1024Array(my23LC1024 **srams, const uint8_t numChips, const int32_t stripeSize=MY_23LC1024_STRIPE_SIZE);
+/* ################ Public functions: ############## */
+        /**
+         * @brief Read from the array.
+         * @param address Address to start reading from.
+         * @param buffer Buffer for the data.
+         * @param length Number of bytes to read.
+         * @return int32_t Returns the number of bytes read, negative for error code.
+         */
+        int32_t read(const int32_t address, uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Write to the array.
+         * @param address Address to start writing to.
+         * @param buffer Data to write.
+         * @param length Number of bytes to write.
+         * @return int32_t Returns the number of bytes written, negative for error code.
+         */
+        int32_t write(const int32_t address, const uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Get the length of the array.
+         * @return int32_t Total bytes across all chips.
+         */
+        int32_t getLength();
+        /**
+         * @brief Get the stripe size.
+         * @return int32_t Bytes per stripe.
+         */
+        int32_t getStripeSize();
+        /**
+         * @brief Get the number of chips.
+         * @return uint8_t Number of chips in the array.
+         */
+        uint8_t getNumChips();
+
+    private:
+/* ################ Private variables: ############### */
+        my23LC1024 *_srams[MAX_CHIPS];
+        uint8_t _numChips;
+        int32_t _stripeSize;
+        uint8_t _busMasks[MAX_CHIPS];       // Chips sharing each chip's bus, itself included.
+        uint8_t _running = 0;               // Chips with a transfer started.
+/* ################ Private functions: ############### */
+        int32_t __transfer__(const bool write, const int32_t address, uint8_t *buffer, const int32_t length);
+        int32_t __waitChips__(const uint8_t mask);                  // Finish transfers running on the chips in mask.
+};
+
+/* ################## Constructor: ################### */
+my23LC1024Array::my23LC1024Array(my23LC1024 **srams, const uint8_t numChips, const int32_t stripeSize) {
+    _numChips = MIN(MAX(numChips, 1), MAX_CHIPS);
+    for (uint8_t i=0; i<_numChips; i++) { _srams[i] = srams[i]; }
+    _stripeSize = 32;
+    while (_stripeSize * 2 <= stripeSize and _stripeSize < my23LC1024::LENGTH) { _stripeSize *= 2; }
+    for (uint8_t i=0; i<_numChips; i++) {
+        _busMasks[i] = 0;
+        for (uint8_t j=0; j<_numChips; j++) {
+            if (i == j or _srams[i]->sharesBus(*_srams[j]) == true) { _busMasks[i] |= 1u << j; }
+        }
+    }
+}
+
+/* ################## Public functions: ################## */
+int32_t my23LC1024Array::read(const int32_t address, uint8_t *buffer, const int32_t length) {
+    return __transfer__(false, address, buffer, length);
+}
+
+int32_t my23LC1024Array::write(const int32_t address, const uint8_t *buffer, const int32_t length) {
+    return __transfer__(true, address, (uint8_t *)buffer, length);
+}
+
+int32_t my23LC1024Array::getLength() {
+    return _numChips * my23LC1024::LENGTH;
+}
+
+int32_t my23LC1024Array::getStripeSize() {
+    return _stripeSize;
+}
+
+uint8_t my23LC1024Array::getNumChips() {
+    return _numChips;
+}
+
+/* ################## Private functions: ################# */
+int32_t my23LC1024Array::__transfer__(const bool write, const int32_t address, uint8_t *buffer, const int32_t length) {
+    if (address < 0 or address >= getLength()) { return ERROR_INVALID_ADDRESS; }
+    if (length < 1 or length > getLength() - address) { return ERROR_INVALID_LENGTH; }
+    int32_t done = 0;
+    while (done < length) {
+        const int32_t position = address + done;
+        const int32_t stripe = position / _stripeSize;
+        const int32_t offset = position % _stripeSize;
+        const uint8_t chip = stripe % _numChips;
+        const int32_t chipAddress = ((stripe / _numChips) * _stripeSize) + offset;
+        const int32_t chunk = MIN(_stripeSize - offset, length - done);
+    // Free the chip's bus, then start its stripe and move on without waiting:
+        int32_t returnValue = __waitChips__(_busMasks[chip]);
+        if (returnValue >= 0) {
+            if (write == true) {
+                returnValue = _srams[chip]->startWriteBuffer(chipAddress, &buffer[done], chunk);
+            } else {
+                returnValue = _srams[chip]->startReadBuffer(chipAddress, &buffer[done], chunk);
+            }
+        }
+        if (returnValue < 0) {
+            __waitChips__(_running);
+            return returnValue;
+        }
+        _running |= 1u << chip;
+        done += chunk;
+    }
+    int32_t returnValue = __waitChips__(_running);
+    if (returnValue < 0) { return returnValue; }
+    return length;
+}
+
+int32_t my23LC1024Array::__waitChips__(const uint8_t mask) {
+    int32_t returnValue = NO_ERROR;
+    for (uint8_t i=0; i<_numChips; i++) {
+        if ((_running & mask & (1u << i)) == 0) { continue; }
+        int32_t result = _srams[i]->waitBuffer();
+        if (result < 0) { returnValue = result; }
+        _running &= ~(1u << i);
+    }
+    return returnValue;
+}
+#endif
@@ -0,0 +1,279 @@
+/**
+ * @file my23LC1024Cache.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Write back line cache for the 23LC1024.
+ * @version 0.1
+ * @date 2022-08-09
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY23LC1024_CACHE_H
+#define MY23LC1024_CACHE_H
+
+#include "../myStandardDefines.hpp"
+#include "../myErrorCodes.hpp"
+#include "my23LC1024.hpp"
+/**
+ * @brief Write back line cache for the 23LC1024.
+ * Keeps MY_23LC1024_CACHE_LINES lines of 32 bytes, one sram page each, in RAM. Reads and writes
+ * that hit a cached line don't touch the bus. A miss loads the whole line in one burst, evicting
+ * the least recently used line, which is written back first if dirty. A write covering a whole
+ * line doesn't load it.
+ * @note Writes reach the sram on eviction or flush(). Direct sram access bypasses the cache, so
+ * flush() before, and invalidate() after.
+ */
+class my23LC1024Cache {
+
+    public:
+/* ################### Types: ##################### */
+        /**
+         * @brief Cache counters.
+         * Returned by getStats(), cleared by resetStats().
+         */
+        struct stats_t {
+            uint32_t hits = 0;              // Line lookups found in the cache.
+            uint32_t misses = 0;            // Line lookups that loaded from the sram, or allocated.
+            uint32_t writeBacks = 0;        // Dirty lines written to the sram.
+        };
+/* ################### Constants: ################# */
+        /**
+         * @brief Number of cache lines.
+         */
+        static const uint8_t NUM_LINES = MY_23LC1024_CACHE_LINES;
+        /**
+         * @brief Size of a cache line, one sram page.
+         */
+        static const int32_t LINE_SIZE = 32;
+    // Error codes:
+        /**
+         * @brief No error. Value 0.
+         */
+        static const int32_t NO_ERROR = MY_NO_ERROR;
+        /**
+         * @brief Invalid address. Value -301.
+         * The address is negative or past the end of the sram.
+         */
+        static const int32_t ERROR_INVALID_ADDRESS = MY_ERROR_MY23LC1024_INVALID_ADDRESS;
+        /**
+         * @brief Invalid length. Value -311.
+         * The length is zero, or runs past the end of the sram.
+         */
+        static const int32_t ERROR_INVALID_LENGTH = MY_ERROR_MY23LC1024_INVALID_LENGTH;
+/* ################## Constructor: ################ */
+        /**
+         * @brief Construct a new my23LC1024Cache object.
+         * @param sram Initialized sram to cache, must be idle between cache calls.
+         */
+        my23LC1024Cache(my23LC1024 &sram) : _sram (sram) {}
+/* ################ Public functions: ############## */
+        /**
+         * @brief Read through the cache.
+         * @param address Address to start reading from.
+         * @param buffer Buffer for the data.
+         * @param length Number of bytes to read.
+         * @return int32_t Returns the number of bytes read, negative for error code.
+         */
+        int32_t read(const int32_t address, uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Write through the cache.
+         * The data reaches the sram when its line is evicted or flushed.
+         * @param address Address to start writing to.
+         * @param buffer Data to write.
+         * @param length Number of bytes to write.
+         * @return int32_t Returns the number of bytes written, negative for error code.
+         */
+        int32_t write(const int32_t address, const uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Read a byte through the cache.
+         * @param address Address to read.
+         * @return int32_t Returns the byte read 0-255, negative for error code.
+         */
+        int32_t readByte(const int32_t address);
+        /**
+         * @brief Write a byte through the cache.
+         * @param address Address to write.
+         * @param value Value to write.
+         * @return int32_t Returns 0 (NO_ERROR) if written, negative for error code.
+         */
+        int32_t writeByte(const int32_t address, const uint8_t value);
+        /**
+         * @brief Write all dirty lines to the sram.
+         * Lines stay cached. Dirty lines at consecutive addresses go out in one burst.
+         * @return int32_t Returns 0 (NO_ERROR) if flushed, negative for error code.
+         */
+        int32_t flush();
+        /**
+         * @brief Drop all lines without writing them back.
+         */
+        void invalidate();
+        /**
+         * @brief Get the cache counters.
+         * @return stats_t Copy of the counters.
+         */
+        stats_t getStats();
+        /**
+         * @brief Clear the cache counters.
+         */
+        void resetStats();
+
+    private:
+/* ################ Private variables: ############### */
+        /** @private */
+        struct __line__ {
+            int32_t tag = -1;                       // Address of the line, -1 when empty.
+            uint32_t lastUse = 0;                   // Use stamp for LRU.
+            bool dirty = false;
+            uint8_t data[LINE_SIZE];
+        };
+        my23LC1024 &_sram;
+        __line__ _lines[NUM_LINES];
+        uint32_t _useCount = 0;
+        stats_t _stats;
+/* ################ Private functions: ############### */
+        int32_t __validate__(const int32_t address, const int32_t length);
+        int32_t __getLine__(const int32_t tag, const bool load);   // Index of the line, loading or allocating on miss.
+        int32_t __writeBack__(__line__ &line);
+};
+
+/* ################## Public functions: ################## */
+int32_t my23LC1024Cache::read(const int32_t address, uint8_t *buffer, const int32_t length) {
+    int32_t returnValue = __validate__(address, length);
+    if (returnValue < 0) { return returnValue; }
+    int32_t done = 0;
+    while (done < length) {
+        const int32_t position = address + done;
+        const int32_t offset = position % LINE_SIZE;
+        const int32_t chunk = MIN(LINE_SIZE - offset, length - done);
+        int32_t index = __getLine__(position - offset, true);
+        if (index < 0) { return index; }
+        memcpy(&buffer[done], &_lines[index].data[offset], chunk);
+        done += chunk;
+    }
+    return length;
+}
+
+int32_t my23LC1024Cache::write(const int32_t address, const uint8_t *buffer, const int32_t length) {
+    int32_t returnValue = __validate__(address, length);
+    if (returnValue < 0) { return returnValue; }
+    int32_t done = 0;
+    while (done < length) {
+        const int32_t position = address + done;
+        const int32_t offset = position % LINE_SIZE;
+        const int32_t chunk = MIN(LINE_SIZE - offset, length - done);
+        int32_t index = __getLine__(position - offset, chunk < LINE_SIZE);  // Whole lines aren't loaded.
+        if (index < 0) { return index; }
+        memcpy(&_lines[index].data[offset], &buffer[done], chunk);
+        _lines[index].dirty = true;
+        done += chunk;
+    }
+    return length;
+}
+
+int32_t my23LC1024Cache::readByte(const int32_t address) {
+    uint8_t value;
+    int32_t returnValue = read(address, &value, 1);
+    if (returnValue < 0) { return returnValue; }
+    return (int32_t)value;
+}
+
+int32_t my23LC1024Cache::writeByte(const int32_t address, const uint8_t value) {
+    int32_t returnValue = write(address, &value, 1);
+    if (returnValue < 0) { return returnValue; }
+    return NO_ERROR;
+}
+
+int32_t my23LC1024Cache::flush() {
+// Write dirty lines in address order, each run of consecutive lines as one burst:
+    uint8_t run[NUM_LINES * LINE_SIZE];
+    uint8_t runLines[NUM_LINES];
+    int32_t lastTag = -1;
+    while (true) {
+        int32_t first = -1;
+        for (uint8_t i=0; i<NUM_LINES; i++) {
+            if (_lines[i].dirty == false or _lines[i].tag <= lastTag) { continue; }
+            if (first < 0 or _lines[i].tag < _lines[first].tag) { first = i; }
+        }
+        if (first < 0) { return NO_ERROR; }
+        const int32_t start = _lines[first].tag;
+        int32_t runLength = 0;
+        uint8_t runCount = 0;
+        bool extended = true;
+        while (extended == true) {
+            extended = false;
+            for (uint8_t i=0; i<NUM_LINES; i++) {
+                if (_lines[i].dirty == false or _lines[i].tag != start + runLength) { continue; }
+                memcpy(&run[runLength], _lines[i].data, LINE_SIZE);
+                runLines[runCount++] = i;
+                runLength += LINE_SIZE;
+                extended = true;
+                break;
+            }
+        }
+        int32_t returnValue = _sram.writeBuffer(start, run, runLength);
+        if (returnValue < 0) { return returnValue; }
+    // Only lines that reached the sram are clean:
+        for (uint8_t i=0; i<runCount; i++) { _lines[runLines[i]].dirty = false; }
+        _stats.writeBacks += runCount;
+        lastTag = start + runLength - LINE_SIZE;
+    }
+}
+
+void my23LC1024Cache::invalidate() {
+    for (uint8_t i=0; i<NUM_LINES; i++) {
+        _lines[i].tag = -1;
+        _lines[i].dirty = false;
+    }
+}
+
+my23LC1024Cache::stats_t my23LC1024Cache::getStats() {
+    return _stats;
+}
+
+void my23LC1024Cache::resetStats() {
+    _stats = stats_t();
+}
+
+/* ################## Private functions: ################# */
+int32_t my23LC1024Cache::__validate__(const int32_t address, const int32_t length) {
+    if (address < 0 or address > my23LC1024::MAX_ADDRESS) { return ERROR_INVALID_ADDRESS; }
+    if (length < 1 or length > my23LC1024::LENGTH - address) { return ERROR_INVALID_LENGTH; }
+    return NO_ERROR;
+}
+
+int32_t my23LC1024Cache::__getLine__(const int32_t tag, const bool load) {
+    uint8_t victim = 0;
+    for (uint8_t i=0; i<NUM_LINES; i++) {
+        if (_lines[i].tag == tag) {
+            _lines[i].lastUse = ++_useCount;
+            _stats.hits++;
+            return i;
+        }
+    // Prefer an empty line, then the least recently used:
+        if (_lines[victim].tag < 0) { continue; }
+        if (_lines[i].tag < 0 or _lines[i].lastUse < _lines[victim].lastUse) { victim = i; }
+    }
+    _stats.misses++;
+    __line__ &line = _lines[victim];
+    if (line.dirty == true) {
+        int32_t returnValue = __writeBack__(line);
+        if (returnValue < 0) { return returnValue; }
+    }
+    line.tag = -1;
+    if (load == true) {
+        int32_t returnValue = _sram.readBuffer(tag, line.data, LINE_SIZE);
+        if (returnValue < 0) { return returnValue; }
+    }
+    line.tag = tag;
+    line.lastUse = ++_useCount;
+    return victim;
+}
+
+int32_t my23LC1024Cache::__writeBack__(__line__ &line) {
+    int32_t returnValue = _sram.writeBuffer(line.tag, line.data, LINE_SIZE);
+    if (returnValue < 0) { return returnValue; }
+    line.dirty = false;
+    _stats.writeBacks++;
+    return NO_ERROR;
+}
+#endif
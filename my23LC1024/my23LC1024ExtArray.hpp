@@ -0,0 +1,236 @@
+/**
+ * @file my23LC1024ExtArray.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Typed array in the 23LC1024.
+ * @version 0.1
+ * @date 2022-08-09
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY23LC1024_EXT_ARRAY_H
+#define MY23LC1024_EXT_ARRAY_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include "../myStandardDefines.hpp"
+#include "../myErrorCodes.hpp"
+#include "my23LC1024.hpp"
+/**
+ * @brief Typed array in the 23LC1024.
+ * An array of T laid out from a base address in the sram. Elements are read and written as raw
+ * bytes, like my25xx640A::readAnything / writeAnything, so T must be trivially copyable. Iterators
+ * prefetch MY_23LC1024_EXT_WINDOW_SIZE bytes of elements per burst, so a loop over the array
+ * pays one transaction per window rather than per element.
+ * @note Iterators are read only, and don't see set() or copyIn() calls made after their window
+ * was fetched. The sram must be idle between calls.
+ * @tparam T Element type.
+ */
+template <typename T>
+class my23LC1024ExtArray {
+    static_assert(std::is_trivially_copyable<T>::value, "my23LC1024ExtArray needs a trivially copyable type.");
+
+    public:
+/* ################### Constants: ################# */
+        /**
+         * @brief Elements fetched per iterator window.
+         */
+        static const int32_t WINDOW_ELEMENTS = MAX(MY_23LC1024_EXT_WINDOW_SIZE / (int32_t)sizeof(T), 1);
+    // Error codes:
+        /**
+         * @brief No error. Value 0.
+         */
+        static const int32_t NO_ERROR = MY_NO_ERROR;
+        /**
+         * @brief Invalid address. Value -301.
+         * The index is out of range.
+         */
+        static const int32_t ERROR_INVALID_ADDRESS = MY_ERROR_MY23LC1024_INVALID_ADDRESS;
+        /**
+         * @brief Invalid length. Value -311.
+         * The count is zero, or runs past the end of the array.
+         */
+        static const int32_t ERROR_INVALID_LENGTH = MY_ERROR_MY23LC1024_INVALID_LENGTH;
+/* ################### Types: ##################### */
+        /**
+         * @brief Input iterator over the array.
+         * Holds a window of elements, refilled by one burst when it runs off the end. If the burst
+         * fails, a value initialized T is returned, and getError() holds the error code.
+         * @note Single pass: a reference points into the iterator's own window, and is good until
+         * the iterator moves off it. Each copy carries a window, so prefer ++it to it++.
+         */
+        class iterator {
+            public:
+                typedef std::input_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const T *pointer;
+                typedef const T &reference;
+
+                iterator() : _array (nullptr), _index (0) {}
+                iterator(my23LC1024ExtArray *array, const int32_t index) : _array (array), _index (index) {}
+                const T &operator*() {
+                    if (_index < _first or _index >= _first + _count) { __fetch__(); }
+                    return _window[_index - _first];
+                }
+                const T *operator->() { return &(**this); }
+                iterator &operator++() { _index++; return *this; }
+                iterator operator++(int) { iterator previous = *this; _index++; return previous; }
+                bool operator==(const iterator &other) const { return _index == other._index; }
+                bool operator!=(const iterator &other) const { return _index != other._index; }
+                /**
+                 * @brief Get the index the iterator points at.
+                 * @return int32_t Element index.
+                 */
+                int32_t getIndex() const { return _index; }
+                /**
+                 * @brief Get the result of the last window fetch.
+                 * @return int32_t Returns 0 (NO_ERROR) if it was read, negative for error code.
+                 */
+                int32_t getError() const { return _error; }
+            private:
+                my23LC1024ExtArray *_array;
+                int32_t _index;
+                int32_t _first = 0;             // Index of the first element in the window.
+                int32_t _count = 0;             // Elements in the window.
+                int32_t _error = NO_ERROR;      // Result of the last fetch.
+                T _window[WINDOW_ELEMENTS];
+                void __fetch__() {
+                    _first = _index;
+                    _count = MIN(WINDOW_ELEMENTS, _array->_count - _index);
+                    _error = _array->copyOut(_first, _window, _count);
+                    if (_error < 0) {
+                    // Retry on the next access, and don't hand back stale or unset bytes:
+                        _count = 0;
+                        _window[0] = T();
+                        return;
+                    }
+                    _error = NO_ERROR;
+                }
+        };
+/* ################## Constructor: ################ */
+        /**
+         * @brief Construct a new my23LC1024ExtArray object.
+         * @param sram Initialized sram to hold the array.
+         * @param base Address of element 0.
+         * @param count Number of elements, cut to what fits between base and the end of the sram.
+         */
+        my23LC1024ExtArray(my23LC1024 &sram, const int32_t base, const int32_t count);
+/* ################ Public functions: ############## */
+        /**
+         * @brief Get an element.
+         * @param index Index of the element.
+         * @param value Value read.
+         * @return int32_t Returns 0 (NO_ERROR) if read, negative for error code.
+         */
+        int32_t get(const int32_t index, T &value);
+        /**
+         * @brief Set an element.
+         * @param index Index of the element.
+         * @param value Value to write.
+         * @return int32_t Returns 0 (NO_ERROR) if written, negative for error code.
+         */
+        int32_t set(const int32_t index, const T &value);
+        /**
+         * @brief Copy elements out of the array in one burst.
+         * @param first Index of the first element.
+         * @param values Buffer for the elements.
+         * @param count Number of elements.
+         * @return int32_t Returns the number of elements copied, negative for error code.
+         */
+        int32_t copyOut(const int32_t first, T *values, const int32_t count);
+        /**
+         * @brief Copy elements into the array in one burst.
+         * @param first Index of the first element.
+         * @param values Elements to copy.
+         * @param count Number of elements.
+         * @return int32_t Returns the number of elements copied, negative for error code.
+         */
+        int32_t copyIn(const int32_t first, const T *values, const int32_t count);
+        /**
+         * @brief Get the number of elements.
+         * @return int32_t Number of elements.
+         */
+        int32_t size();
+        /**
+         * @brief Iterator at the first element.
+         */
+        iterator begin();
+        /**
+         * @brief Iterator past the last element.
+         */
+        iterator end();
+
+    private:
+/* ################ Private variables: ############### */
+        my23LC1024 &_sram;
+        int32_t _base;
+        int32_t _count;
+/* ################ Private functions: ############### */
+        int32_t __validate__(const int32_t first, const int32_t count);
+};
+
+/* ################## Constructor: ################### */
+template <typename T>
+my23LC1024ExtArray<T>::my23LC1024ExtArray(my23LC1024 &sram, const int32_t base, const int32_t count) : _sram (sram) {
+    _base = MIN(MAX(base, 0), my23LC1024::MAX_ADDRESS);
+    _count = MIN(MAX(count, 0), (my23LC1024::LENGTH - _base) / (int32_t)sizeof(T));
+}
+
+/* ################## Public functions: ################## */
+template <typename T>
+int32_t my23LC1024ExtArray<T>::get(const int32_t index, T &value) {
+    int32_t returnValue = copyOut(index, &value, 1);
+    if (returnValue < 0) { return returnValue; }
+    return NO_ERROR;
+}
+
+template <typename T>
+int32_t my23LC1024ExtArray<T>::set(const int32_t index, const T &value) {
+    int32_t returnValue = copyIn(index, &value, 1);
+    if (returnValue < 0) { return returnValue; }
+    return NO_ERROR;
+}
+
+template <typename T>
+int32_t my23LC1024ExtArray<T>::copyOut(const int32_t first, T *values, const int32_t count) {
+    int32_t returnValue = __validate__(first, count);
+    if (returnValue < 0) { return returnValue; }
+    returnValue = _sram.readBuffer(_base + (first * sizeof(T)), (uint8_t *)values, count * sizeof(T));
+    if (returnValue < 0) { return returnValue; }
+    return count;
+}
+
+template <typename T>
+int32_t my23LC1024ExtArray<T>::copyIn(const int32_t first, const T *values, const int32_t count) {
+    int32_t returnValue = __validate__(first, count);
+    if (returnValue < 0) { return returnValue; }
+    returnValue = _sram.writeBuffer(_base + (first * sizeof(T)), (const uint8_t *)values, count * sizeof(T));
+    if (returnValue < 0) { return returnValue; }
+    return count;
+}
+
+template <typename T>
+int32_t my23LC1024ExtArray<T>::size() {
+    return _count;
+}
+
+template <typename T>
+typename my23LC1024ExtArray<T>::iterator my23LC1024ExtArray<T>::begin() {
+    return iterator(this, 0);
+}
+
+template <typename T>
+typename my23LC1024ExtArray<T>::iterator my23LC1024ExtArray<T>::end() {
+    return iterator(this, _count);
+}
+
+/* ################## Private functions: ################# */
+template <typename T>
+int32_t my23LC1024ExtArray<T>::__validate__(const int32_t first, const int32_t count) {
+    if (first < 0 or first >= _count) { return ERROR_INVALID_ADDRESS; }
+    if (count < 1 or count > _count - first) { return ERROR_INVALID_LENGTH; }
+    return NO_ERROR;
+}
+#endif
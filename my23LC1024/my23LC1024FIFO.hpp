@@ -0,0 +1,321 @@
+/**
+ * @file my23LC1024FIFO.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Streaming byte FIFO in the 23LC1024.
+ * @version 0.1
+ * @date 2022-08-09
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY23LC1024_FIFO_H
+#define MY23LC1024_FIFO_H
+
+#include <hardware/sync.h>
+#include "../myStandardDefines.hpp"
+#include "../myErrorCodes.hpp"
+#include "../mySpinLock/mySpinLock.hpp"
+#include "my23LC1024.hpp"
+/**
+ * @brief Streaming byte FIFO in the 23LC1024.
+ * A ring buffer in a region of the sram, with one producer and one consumer, which may be on
+ * different cores. Each side batches through a MY_23LC1024_FIFO_STAGE_SIZE byte RAM stage, so the
+ * sram is only touched in stage sized bursts. When the region is the whole sram, bursts run
+ * across the end of the array and the chip's sequential mode wraps them to 0.
+ * @note Pushed bytes reach the consumer when the push stage fills, or on flush(). A spin lock
+ * guards the shared byte count and the sram owner; it isn't held during bursts. A side that finds
+ * the sram mid burst on the other core waits for it, but one that interrupted a burst on its own
+ * core, IE: a producer in an IRQ, gets ERROR_SRAM_BUSY rather than waiting forever.
+ */
+class my23LC1024FIFO {
+
+    public:
+/* ################### Types: ##################### */
+        /**
+         * @brief FIFO counters.
+         * Returned by getStats(), cleared by resetStats().
+         */
+        struct stats_t {
+            int32_t highWater = 0;          // Most bytes held in the sram.
+            uint32_t overflows = 0;         // Pushes that couldn't take all their bytes.
+            uint32_t droppedBytes = 0;      // Bytes refused by those pushes.
+        };
+/* ################### Constants: ################# */
+        /**
+         * @brief Size of each staging buffer.
+         */
+        static const int32_t STAGE_SIZE = MY_23LC1024_FIFO_STAGE_SIZE;
+    // Error codes:
+        /**
+         * @brief No error. Value 0.
+         */
+        static const int32_t NO_ERROR = MY_NO_ERROR;
+        /**
+         * @brief Invalid length. Value -311.
+         * The length was less than 1.
+         */
+        static const int32_t ERROR_INVALID_LENGTH = MY_ERROR_MY23LC1024_INVALID_LENGTH;
+        /**
+         * @brief Sram busy. Value -302.
+         * The call interrupted a burst on the same core, retry once the interrupted side is done.
+         */
+        static const int32_t ERROR_SRAM_BUSY = MY_ERROR_MY23LC1024_SRAM_BUSY;
+/* ################## Constructor: ################ */
+        /**
+         * @brief Construct a new my23LC1024FIFO object.
+         * @param sram Initialized sram to buffer in, used only through this FIFO while it's in use.
+         * @param base First address of the ring. Defaults to 0.
+         * @param length Length of the ring in bytes. Defaults to the whole sram.
+         */
+        my23LC1024FIFO(my23LC1024 &sram, const int32_t base=0, const int32_t length=my23LC1024::LENGTH);
+        /**
+         * @brief Destroy the my23LC1024FIFO object.
+         * Releases the spin lock.
+         */
+        ~my23LC1024FIFO();
+/* ################ Public functions: ############## */
+        /**
+         * @brief Push bytes, producer side.
+         * Bytes that don't fit in the stage and the ring are refused and counted as an overflow.
+         * @param data Bytes to push.
+         * @param length Number of bytes to push.
+         * @return int32_t Returns the number of bytes taken, negative for error code. An error after
+         * some bytes were taken returns the count instead, a retry returns it if it persists.
+         */
+        int32_t push(const uint8_t *data, const int32_t length);
+        /**
+         * @brief Write the push stage to the sram, producer side.
+         * Call at the end of a burst so the consumer sees a partial stage.
+         * @return int32_t Returns the number of bytes written, negative for error code.
+         */
+        int32_t flush();
+        /**
+         * @brief Pop bytes, consumer side.
+         * @param buffer Buffer for the bytes.
+         * @param length Most bytes to pop.
+         * @return int32_t Returns the number of bytes popped, 0 if empty, negative for error code. An
+         * error after some bytes were popped returns the count instead, a retry returns it if it
+         * persists.
+         */
+        int32_t pop(uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Get the number of bytes ready to pop, consumer side.
+         * @return int32_t Bytes in the sram and the pop stage.
+         */
+        int32_t available();
+        /**
+         * @brief Get the capacity of the ring.
+         * @return int32_t Ring length in bytes, not counting the stages.
+         */
+        int32_t getCapacity();
+        /**
+         * @brief Get the FIFO counters.
+         * @return stats_t Copy of the counters.
+         */
+        stats_t getStats();
+        /**
+         * @brief Clear the FIFO counters.
+         * The high water mark restarts at the current fill.
+         */
+        void resetStats();
+
+    private:
+/* ################ Private variables: ############### */
+        my23LC1024 &_sram;
+        int32_t _base;
+        int32_t _length;
+        int16_t _lockNum;
+    // Shared, under the lock:
+        volatile int32_t _count = 0;                // Bytes in the ring.
+        volatile int8_t _sramOwner = -1;            // Core running a burst, -1 for none.
+        stats_t _stats;
+    // Producer side:
+        int32_t _tail = 0;                          // Ring offset of the next byte to write.
+        uint8_t _pushStage[STAGE_SIZE];
+        int32_t _pushLength = 0;
+    // Consumer side:
+        int32_t _head = 0;                          // Ring offset of the next byte to read.
+        uint8_t _popStage[STAGE_SIZE];
+        int32_t _popIndex = 0;
+        int32_t _popLength = 0;
+/* ################ Private functions: ############### */
+        int32_t __commitPush__();                                                       // Stage to ring, returns bytes written.
+        int32_t __fillPop__();                                                          // Ring to stage, returns bytes read.
+        int32_t __burst__(const bool write, const int32_t offset, uint8_t *buffer, const int32_t length);
+        int32_t __claimSram__();
+        void __releaseSram__();
+};
+
+/* ################## Constructor: ################### */
+my23LC1024FIFO::my23LC1024FIFO(my23LC1024 &sram, const int32_t base, const int32_t length) : _sram (sram) {
+    _base = MIN(MAX(base, 0), my23LC1024::MAX_ADDRESS);
+    _length = MIN(MAX(length, 1), my23LC1024::LENGTH - _base);
+    mySpinLock lock(mySpinLock::GENERATE_LOCK_NUM);
+    _lockNum = lock.getLockNum();
+}
+
+my23LC1024FIFO::~my23LC1024FIFO() {
+    mySpinLock::release(_lockNum);
+}
+
+/* ################## Public functions: ################## */
+int32_t my23LC1024FIFO::push(const uint8_t *data, const int32_t length) {
+    if (length < 1) { return ERROR_INVALID_LENGTH; }
+    int32_t taken = 0;
+    while (taken < length) {
+        if (_pushLength == STAGE_SIZE) {
+            int32_t returnValue = __commitPush__();
+            if (returnValue < 0) {
+                if (taken > 0) { return taken; }    // Staged bytes are kept, report them.
+                return returnValue;
+            }
+            if (returnValue == 0) { break; }        // Ring is full.
+        }
+        const int32_t chunk = MIN(STAGE_SIZE - _pushLength, length - taken);
+        memcpy(&_pushStage[_pushLength], &data[taken], chunk);
+        _pushLength += chunk;
+        taken += chunk;
+    }
+    if (taken < length) {
+        mySpinLock lock(_lockNum);
+        lock.lockBlocking();
+        _stats.overflows++;
+        _stats.droppedBytes += length - taken;
+        lock.unlock();
+    }
+    return taken;
+}
+
+int32_t my23LC1024FIFO::flush() {
+    if (_pushLength == 0) { return 0; }
+    return __commitPush__();
+}
+
+int32_t my23LC1024FIFO::pop(uint8_t *buffer, const int32_t length) {
+    if (length < 1) { return ERROR_INVALID_LENGTH; }
+    int32_t popped = 0;
+    while (popped < length) {
+        if (_popIndex == _popLength) {
+            int32_t returnValue = __fillPop__();
+            if (returnValue < 0) {
+                if (popped > 0) { return popped; }  // Copied bytes are gone from the stage, report them.
+                return returnValue;
+            }
+            if (returnValue == 0) { break; }        // Ring is empty.
+        }
+        const int32_t chunk = MIN(_popLength - _popIndex, length - popped);
+        memcpy(&buffer[popped], &_popStage[_popIndex], chunk);
+        _popIndex += chunk;
+        popped += chunk;
+    }
+    return popped;
+}
+
+int32_t my23LC1024FIFO::available() {
+    return _count + (_popLength - _popIndex);
+}
+
+int32_t my23LC1024FIFO::getCapacity() {
+    return _length;
+}
+
+my23LC1024FIFO::stats_t my23LC1024FIFO::getStats() {
+    mySpinLock lock(_lockNum);
+    lock.lockBlocking();
+    stats_t stats = _stats;
+    lock.unlock();
+    return stats;
+}
+
+void my23LC1024FIFO::resetStats() {
+    mySpinLock lock(_lockNum);
+    lock.lockBlocking();
+    _stats = stats_t();
+    _stats.highWater = _count;
+    lock.unlock();
+}
+
+/* ################## Private functions: ################# */
+int32_t my23LC1024FIFO::__commitPush__() {
+// Only the producer adds to the count, so the free space can only grow until we add to it:
+    const int32_t length = MIN(_pushLength, _length - _count);
+    if (length == 0) { return 0; }
+    int32_t returnValue = __claimSram__();
+    if (returnValue < 0) { return returnValue; }
+    returnValue = __burst__(true, _tail, _pushStage, length);
+    __releaseSram__();
+    if (returnValue < 0) { return returnValue; }
+    _tail = (_tail + length) % _length;
+    _pushLength -= length;
+    memmove(_pushStage, &_pushStage[length], _pushLength);
+    mySpinLock lock(_lockNum);
+    lock.lockBlocking();
+    _count += length;
+    _stats.highWater = MAX(_stats.highWater, _count);
+    lock.unlock();
+    return length;
+}
+
+int32_t my23LC1024FIFO::__fillPop__() {
+// Only the consumer takes from the count, so the bytes counted stay written until we take them:
+    const int32_t length = MIN(_count, STAGE_SIZE);
+    if (length == 0) { return 0; }
+    int32_t returnValue = __claimSram__();
+    if (returnValue < 0) { return returnValue; }
+    returnValue = __burst__(false, _head, _popStage, length);
+    __releaseSram__();
+    if (returnValue < 0) { return returnValue; }
+    _head = (_head + length) % _length;
+    _popIndex = 0;
+    _popLength = length;
+    mySpinLock lock(_lockNum);
+    lock.lockBlocking();
+    _count -= length;
+    lock.unlock();
+    return length;
+}
+
+int32_t my23LC1024FIFO::__burst__(const bool write, const int32_t offset, uint8_t *buffer, const int32_t length) {
+// The whole array wraps in sequential mode, a smaller region is split at its end:
+    int32_t first = length;
+    if (_length < my23LC1024::LENGTH) { first = MIN(length, _length - offset); }
+    int32_t returnValue;
+    if (write == true) {
+        returnValue = _sram.writeBuffer(_base + offset, buffer, first);
+    } else {
+        returnValue = _sram.readBuffer(_base + offset, buffer, first);
+    }
+    if (returnValue < 0 or first == length) { return returnValue; }
+    if (write == true) {
+        returnValue = _sram.writeBuffer(_base, &buffer[first], length - first);
+    } else {
+        returnValue = _sram.readBuffer(_base, &buffer[first], length - first);
+    }
+    if (returnValue < 0) { return returnValue; }
+    return length;
+}
+
+int32_t my23LC1024FIFO::__claimSram__() {
+    const int8_t core = (int8_t)get_core_num();
+    mySpinLock lock(_lockNum);
+    while (true) {
+        lock.lockBlocking();
+        if (_sramOwner < 0) {
+            _sramOwner = core;
+            lock.unlock();
+            return NO_ERROR;
+        }
+        lock.unlock();
+    // The burst we interrupted can't finish until we return:
+        if (_sramOwner == core) { return ERROR_SRAM_BUSY; }
+        tight_loop_contents();
+    }
+}
+
+void my23LC1024FIFO::__releaseSram__() {
+    mySpinLock lock(_lockNum);
+    lock.lockBlocking();
+    _sramOwner = -1;
+    lock.unlock();
+}
+#endif
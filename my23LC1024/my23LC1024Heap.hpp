@@ -0,0 +1,317 @@
+/**
+ * @file my23LC1024Heap.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Handle based heap in the 23LC1024.
+ * @version 0.1
+ * @date 2022-08-09
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY23LC1024_HEAP_H
+#define MY23LC1024_HEAP_H
+
+#include "../myStandardDefines.hpp"
+#include "../myErrorCodes.hpp"
+#include "my23LC1024.hpp"
+/**
+ * @brief Handle based heap in the 23LC1024.
+ * Hands out blocks of sram as handles, rounded up to 32 byte granules. Blocks are placed first
+ * fit, and when no gap is large enough but the total free space is, the heap is compacted and the
+ * allocation retried. Compaction slides blocks down to close gaps, so a block's address is only
+ * stable while it's pinned; pinned blocks are left in place.
+ * @note Access a block with read() and write(), or pin() it and use the address returned directly
+ * until unpin().
+ */
+class my23LC1024Heap {
+
+    public:
+/* ################### Constants: ################# */
+        /**
+         * @brief Number of handles.
+         */
+        static const uint8_t NUM_HANDLES = MY_23LC1024_HEAP_HANDLES;
+        /**
+         * @brief Allocation granule in bytes.
+         */
+        static const int32_t GRANULE = 32;
+    // Error codes:
+        /**
+         * @brief No error. Value 0.
+         */
+        static const int32_t NO_ERROR = MY_NO_ERROR;
+        /**
+         * @brief Invalid length. Value -311.
+         * The size is zero, or the range runs past the end of the block.
+         */
+        static const int32_t ERROR_INVALID_LENGTH = MY_ERROR_MY23LC1024_INVALID_LENGTH;
+        /**
+         * @brief Invalid handle. Value -312.
+         * The handle is out of range or not allocated.
+         */
+        static const int32_t ERROR_INVALID_HANDLE = MY_ERROR_MY23LC1024_INVALID_HANDLE;
+        /**
+         * @brief Out of memory. Value -313.
+         * Not enough free space, even after compacting.
+         */
+        static const int32_t ERROR_OUT_OF_MEMORY = MY_ERROR_MY23LC1024_OUT_OF_MEMORY;
+        /**
+         * @brief No free handles. Value -314.
+         */
+        static const int32_t ERROR_NO_HANDLES = MY_ERROR_MY23LC1024_NO_HANDLES;
+        /**
+         * @brief Handle pinned. Value -315.
+         * Pinned blocks can't be freed.
+         */
+        static const int32_t ERROR_HANDLE_PINNED = MY_ERROR_MY23LC1024_HANDLE_PINNED;
+        /**
+         * @brief Handle not pinned. Value -316.
+         * Unpin called more times than pin.
+         */
+        static const int32_t ERROR_HANDLE_NOT_PINNED = MY_ERROR_MY23LC1024_HANDLE_NOT_PINNED;
+/* ################## Constructor: ################ */
+        /**
+         * @brief Construct a new my23LC1024Heap object.
+         * @param sram Initialized sram to allocate from, must be idle between heap calls.
+         * @param base First address of the heap, rounded up to a granule. Defaults to 0.
+         * @param length Length of the heap region in bytes. Defaults to the whole sram.
+         */
+        my23LC1024Heap(my23LC1024 &sram, const int32_t base=0, const int32_t length=my23LC1024::LENGTH);
+/* ################ Public functions: ############## */
+        /**
+         * @brief Allocate a block.
+         * @param size Size in bytes.
+         * @return int32_t Returns the handle, negative for error code.
+         */
+        int32_t alloc(const int32_t size);
+        /**
+         * @brief Free a block.
+         * @param handle Handle to free.
+         * @return int32_t Returns 0 (NO_ERROR) if freed, negative for error code.
+         */
+        int32_t free(const int32_t handle);
+        /**
+         * @brief Read from a block.
+         * @param handle Handle to read.
+         * @param offset Offset into the block.
+         * @param buffer Buffer for the data.
+         * @param length Number of bytes to read.
+         * @return int32_t Returns the number of bytes read, negative for error code.
+         */
+        int32_t read(const int32_t handle, const int32_t offset, uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Write to a block.
+         * @param handle Handle to write.
+         * @param offset Offset into the block.
+         * @param buffer Data to write.
+         * @param length Number of bytes to write.
+         * @return int32_t Returns the number of bytes written, negative for error code.
+         */
+        int32_t write(const int32_t handle, const int32_t offset, const uint8_t *buffer, const int32_t length);
+        /**
+         * @brief Pin a block in place.
+         * Pins nest, the block stays put until unpinned as many times.
+         * @param handle Handle to pin.
+         * @return int32_t Returns the sram address of the block, negative for error code.
+         */
+        int32_t pin(const int32_t handle);
+        /**
+         * @brief Unpin a block.
+         * @param handle Handle to unpin.
+         * @return int32_t Returns 0 (NO_ERROR) if unpinned, negative for error code.
+         */
+        int32_t unpin(const int32_t handle);
+        /**
+         * @brief Close the gaps between blocks.
+         * Moves unpinned blocks down, copying through a RAM buffer.
+         * @return int32_t Returns the largest free gap in bytes after compacting, negative for
+         * error code.
+         */
+        int32_t compact();
+        /**
+         * @brief Get the size of a block.
+         * @param handle Handle of the block.
+         * @return int32_t Returns the size requested at alloc, negative for error code.
+         */
+        int32_t getSize(const int32_t handle);
+        /**
+         * @brief Get the total free space.
+         * @return int32_t Free bytes, not necessarily contiguous.
+         */
+        int32_t getFree();
+        /**
+         * @brief Get the largest free gap.
+         * @return int32_t Largest free gap in bytes.
+         */
+        int32_t getLargestFree();
+
+    private:
+/* ################ Private variables: ############### */
+        /** @private */
+        struct __block__ {
+            int32_t address = -1;               // Sram address, -1 when the handle is free.
+            int32_t size = 0;                   // Bytes requested.
+            int32_t granules = 0;               // Granules reserved.
+            uint8_t pins = 0;                   // Pin count.
+        };
+        my23LC1024 &_sram;
+        int32_t _base;
+        int32_t _granules;                      // Heap length in granules.
+        __block__ _blocks[NUM_HANDLES];
+/* ################ Private functions: ############### */
+        bool __validHandle__(const int32_t handle);
+        uint8_t __sortBlocks__(uint8_t *order);                             // Allocated handles by address, returns count.
+        int32_t __findGap__(const int32_t granules, int32_t *largest);    // Address of the first gap that fits, -1 if none.
+        int32_t __move__(__block__ &block, const int32_t address);
+};
+
+/* ################## Constructor: ################### */
+my23LC1024Heap::my23LC1024Heap(my23LC1024 &sram, const int32_t base, const int32_t length) : _sram (sram) {
+    _base = ((MAX(base, 0) + GRANULE - 1) / GRANULE) * GRANULE;
+    int32_t end = MIN(MAX(base, 0) + MAX(length, 0), my23LC1024::LENGTH);
+    _granules = MAX(end - _base, 0) / GRANULE;
+}
+
+/* ################## Public functions: ################## */
+int32_t my23LC1024Heap::alloc(const int32_t size) {
+    if (size < 1) { return ERROR_INVALID_LENGTH; }
+    int32_t handle = -1;
+    for (uint8_t i=0; i<NUM_HANDLES; i++) {
+        if (_blocks[i].address < 0) { handle = i; break; }
+    }
+    if (handle < 0) { return ERROR_NO_HANDLES; }
+    const int32_t granules = (size + GRANULE - 1) / GRANULE;
+    if (granules > _granules or granules * GRANULE > getFree()) { return ERROR_OUT_OF_MEMORY; }
+    int32_t largest;
+    int32_t address = __findGap__(granules, &largest);
+    if (address < 0) {
+        int32_t returnValue = compact();
+        if (returnValue < 0) { return returnValue; }
+        address = __findGap__(granules, &largest);
+        if (address < 0) { return ERROR_OUT_OF_MEMORY; }    // Pinned blocks split the space.
+    }
+    _blocks[handle].address = address;
+    _blocks[handle].size = size;
+    _blocks[handle].granules = granules;
+    _blocks[handle].pins = 0;
+    return handle;
+}
+
+int32_t my23LC1024Heap::free(const int32_t handle) {
+    if (__validHandle__(handle) == false) { return ERROR_INVALID_HANDLE; }
+    if (_blocks[handle].pins > 0) { return ERROR_HANDLE_PINNED; }
+    _blocks[handle] = __block__();
+    return NO_ERROR;
+}
+
+int32_t my23LC1024Heap::read(const int32_t handle, const int32_t offset, uint8_t *buffer, const int32_t length) {
+    if (__validHandle__(handle) == false) { return ERROR_INVALID_HANDLE; }
+    if (offset < 0 or length < 1 or length > _blocks[handle].size - offset) { return ERROR_INVALID_LENGTH; }
+    return _sram.readBuffer(_blocks[handle].address + offset, buffer, length);
+}
+
+int32_t my23LC1024Heap::write(const int32_t handle, const int32_t offset, const uint8_t *buffer, const int32_t length) {
+    if (__validHandle__(handle) == false) { return ERROR_INVALID_HANDLE; }
+    if (offset < 0 or length < 1 or length > _blocks[handle].size - offset) { return ERROR_INVALID_LENGTH; }
+    return _sram.writeBuffer(_blocks[handle].address + offset, buffer, length);
+}
+
+int32_t my23LC1024Heap::pin(const int32_t handle) {
+    if (__validHandle__(handle) == false) { return ERROR_INVALID_HANDLE; }
+    _blocks[handle].pins++;
+    return _blocks[handle].address;
+}
+
+int32_t my23LC1024Heap::unpin(const int32_t handle) {
+    if (__validHandle__(handle) == false) { return ERROR_INVALID_HANDLE; }
+    if (_blocks[handle].pins == 0) { return ERROR_HANDLE_NOT_PINNED; }
+    _blocks[handle].pins--;
+    return NO_ERROR;
+}
+
+int32_t my23LC1024Heap::compact() {
+    uint8_t order[NUM_HANDLES];
+    uint8_t count = __sortBlocks__(order);
+    int32_t next = _base;
+    for (uint8_t i=0; i<count; i++) {
+        __block__ &block = _blocks[order[i]];
+        if (block.pins == 0 and block.address > next) {
+            int32_t returnValue = __move__(block, next);
+            if (returnValue < 0) { return returnValue; }
+        }
+        next = block.address + (block.granules * GRANULE);
+    }
+    return getLargestFree();
+}
+
+int32_t my23LC1024Heap::getSize(const int32_t handle) {
+    if (__validHandle__(handle) == false) { return ERROR_INVALID_HANDLE; }
+    return _blocks[handle].size;
+}
+
+int32_t my23LC1024Heap::getFree() {
+    int32_t used = 0;
+    for (uint8_t i=0; i<NUM_HANDLES; i++) {
+        if (_blocks[i].address >= 0) { used += _blocks[i].granules; }
+    }
+    return (_granules - used) * GRANULE;
+}
+
+int32_t my23LC1024Heap::getLargestFree() {
+    int32_t largest;
+    __findGap__(_granules + 1, &largest);
+    return largest;
+}
+
+/* ################## Private functions: ################# */
+bool my23LC1024Heap::__validHandle__(const int32_t handle) {
+    if (handle < 0 or handle >= NUM_HANDLES) { return false; }
+    return _blocks[handle].address >= 0;
+}
+
+uint8_t my23LC1024Heap::__sortBlocks__(uint8_t *order) {
+    uint8_t count = 0;
+    for (uint8_t i=0; i<NUM_HANDLES; i++) {
+        if (_blocks[i].address < 0) { continue; }
+        uint8_t j = count++;
+        while (j > 0 and _blocks[order[j-1]].address > _blocks[i].address) {
+            order[j] = order[j-1];
+            j--;
+        }
+        order[j] = i;
+    }
+    return count;
+}
+
+int32_t my23LC1024Heap::__findGap__(const int32_t granules, int32_t *largest) {
+    uint8_t order[NUM_HANDLES];
+    uint8_t count = __sortBlocks__(order);
+    const int32_t end = _base + (_granules * GRANULE);
+    int32_t gapStart = _base;
+    *largest = 0;
+    for (uint8_t i=0; i<=count; i++) {
+        int32_t gapEnd = end;
+        if (i < count) { gapEnd = _blocks[order[i]].address; }
+        int32_t gap = gapEnd - gapStart;
+        if (gap >= granules * GRANULE) { *largest = MAX(*largest, gap); return gapStart; }
+        *largest = MAX(*largest, gap);
+        if (i < count) { gapStart = gapEnd + (_blocks[order[i]].granules * GRANULE); }
+    }
+    return -1;
+}
+
+int32_t my23LC1024Heap::__move__(__block__ &block, const int32_t address) {
+// Blocks only move down, so copying front to back never overwrites data not yet copied:
+    uint8_t buffer[256];
+    const int32_t length = block.granules * GRANULE;
+    for (int32_t done=0; done<length; done+=sizeof(buffer)) {
+        const int32_t chunk = MIN((int32_t)sizeof(buffer), length - done);
+        int32_t returnValue = _sram.readBuffer(block.address + done, buffer, chunk);
+        if (returnValue < 0) { return returnValue; }
+        returnValue = _sram.writeBuffer(address + done, buffer, chunk);
+        if (returnValue < 0) { return returnValue; }
+    }
+    block.address = address;
+    return NO_ERROR;
+}
+#endif
@@ -15,11 +15,23 @@
 #include <hardware/spi.h>
 #include <pico/time.h>
 
+#include "../myStandardDefines.hpp"
 #include "../mySPI/mySPI.hpp"
 
 class my25xx640A {
 
     public:
+/* ############# Public types: ############### */
+        /**
+         * @brief Background write callback.
+         * Called from the poll timer interrupt when a writePageAsync() write cycle ends, or from
+         * isWriteBusy() or waitWrite() if no alarm was free for the timer.
+         * @param eeprom EEPROM that finished writing.
+         * @param status 0 (NO_ERROR) if the cycle finished, ERROR_TIMEOUT if it didn't finish in
+         * twice the write time.
+         * @param userData Pointer passed to writePageAsync().
+         */
+        typedef void (*writeCallback_t)(my25xx640A *eeprom, const int16_t status, void *userData);
 /* ############# Public constants: ############### */
     // EEPROM constants:
         static const int16_t MAX_ADDRESS = 0x1FFF; // 0b ---1 1111 1111 1111
@@ -35,6 +47,11 @@ class my25xx640A {
          * No error occured.
          */
         static const int16_t NO_ERROR = MY_NO_ERROR;
+        /**
+         * @brief Timeout reached. Value -7.
+         * A write cycle didn't finish in twice the write time, the EEPROM may be gone.
+         */
+        static const int16_t ERROR_TIMEOUT = MY_TIMEOUT;
         /**
          * @brief Invalid chip select pin. Value -153.
          * Invalid cs pin was passed.
@@ -183,8 +200,9 @@ class my25xx640A {
         int16_t startRead(const int16_t address);
         /**
          * @brief Read a buffer from the EEPROM
-         * Reads a buffer from the EEPROM. Returns 0 (NO_ERROR) if read okay, otherwise if the
-         * EEPROM is idle, or held an error code is returned.
+         * Reads a buffer from the EEPROM in one transfer, by DMA. Reads past the end wrap to address
+         * 0. Returns 0 (NO_ERROR) if read okay, otherwise if the EEPROM is idle, or held an error
+         * code is returned.
          * @param recvBuffer Buffer to store read data in.
          * @param len Length of buffer to read.
          * @return int16_t Returns 0(NO_ERROR) if read okay, negative for error code.
@@ -207,8 +225,11 @@ class my25xx640A {
         int16_t startWrite(const int16_t address);
         /**
          * @brief Write a buffer to the EEPROM.
-         * Writes a buffer to the EEPROM. Returns 0 if written okay, otherwise if not writing or
-         * if held, or if write protected, an error code is returned.
+         * Writes a buffer to the EEPROM, split at page boundaries so each page goes in one transfer.
+         * Between pages the status register is polled until the write cycle is done, rather than
+         * waiting the worst case write time. Returns 0 if written okay, otherwise if not writing or
+         * if held, or if write protected, an error code is returned. If a write cycle times out the
+         * write is stopped, and ERROR_TIMEOUT is returned.
          * @param sendBuffer Buffer to send to EEPROM
          * @param len Length of buffer.
          * @return int16_t Return 0 (NO_ERROR) if written okay, negative for error code.
@@ -217,7 +238,7 @@ class my25xx640A {
         /**
          * @brief Write a byte to the EEPROM.
          * Writes a single byte to the EEPROM. Retuns 0 if written okay, Otherwise if not writing, or
-         * is held, or if write protected, an error code is returned.
+         * is held, or if write protected, or if the write cycle timed out, an error code is returned.
          * @param value Value to write to the EEPROM.
          * @return int16_t Returns 0 (NO_ERROR) for okay, negaitve for error code.
          */
@@ -225,10 +246,47 @@ class my25xx640A {
         /**
          * @brief Stop a read / write.
          * Stops a read / write, returns 0 (NO_ERROR) if stopped okay, otherwise if idle, or if
-         * held, or if write protected. an error code is returned.
+         * held, or if write protected. an error code is returned. Stopping a write waits for the
+         * write cycle, if it times out the write is still stopped, and ERROR_TIMEOUT is returned.
          * @return int16_t Return 0 (NO_ERROR) if stopped okay, negative of error code.
          */
         int16_t stop();
+        /**
+         * @brief Write a page without waiting for the write cycle.
+         * Sends the bytes up to the end of the page at address, then returns while the EEPROM
+         * programs them. The data is sent before returning, so sendBuffer can be refilled with the
+         * next page straight away. A repeating timer polls the status register every
+         * MY_25XX640A_POLL_US, and calls callback when the cycle ends. If no alarm is free, the
+         * cycle is polled from isWriteBusy() and waitWrite() instead. Other calls return
+         * ERROR_BUSY until the cycle is done.
+         * @note Each poll claims the SPI port as mySPI::OWNER_TIMER without waiting, and skips the
+         * tick if the port is owned, so other devices on the port should hold it with
+         * mySPI::acquirePort() around their transactions.
+         * @param address Address to start the write at.
+         * @param sendBuffer Data to write.
+         * @param len Length of data, only the bytes up to the end of the page are written.
+         * @param callback Function to call when the cycle is done, nullptr for none.
+         * @param userData Pointer passed to callback.
+         * @return int16_t Returns the number of bytes written, negative for error code.
+         */
+        int16_t writePageAsync(const int16_t address, const uint8_t *sendBuffer, size_t len,
+                                    writeCallback_t callback=nullptr, void *userData=nullptr);
+        /**
+         * @brief Check for a background write cycle.
+         * Without the poll timer, polls the status register of a writePageAsync() write cycle, at
+         * most once every MY_25XX640A_POLL_US. If the cycle has ended, or has run twice the write
+         * time, the EEPROM goes idle and the write callback is called.
+         * @return true A writePageAsync() write cycle is running.
+         * @return false No write cycle is running.
+         */
+        bool isWriteBusy();
+        /**
+         * @brief Wait for a background write cycle.
+         * Blocks until a writePageAsync() write cycle is done, returns straight away if none is
+         * running. A timed out cycle is reported once, by the next call.
+         * @return int16_t Returns 0 (NO_ERROR) when done, ERROR_TIMEOUT if the last cycle timed out.
+         */
+        int16_t waitWrite();
         /**
          * @brief Set the hold pin.
          * Sets the hold pin. Returns 0 (NO_ERROR) if held okay, otherwise if already held, or
@@ -270,7 +328,8 @@ class my25xx640A {
         /**
          * @brief Template to write anything to the EEPROM.
          * Template to write anything to the EEPROM. Returns number of bytes written on success, otherwise
-         * if not writing, or if held, or if write protected, an error code is returned.
+         * if not writing, or if held, or if write protected, or if a write cycle timed out, an error
+         * code is returned.
          * @param value Value to write to EEPROM of any type.
          * @return int32_t Positive, number of bytes written, negative for error code.
          */
@@ -280,8 +339,9 @@ class my25xx640A {
         /**
          * @brief Initialize the EEPROM.
          * Initializes the SPI bus, and sets the current state. Returns 0 (NO_ERROR) if intialized okay, otherwise
-         * if an invalid pin is passed during construction, an error code is returned.
-         * @param initSPI True = initialize SPI bus, False = do not initialize SPI bus, assumes already initialized.
+         * if an invalid pin is passed during construction, an error code is returned. The EEPROM registers a
+         * mySPI profile, so it can share the bus with other devices at its own speed.
+         * @param initSPI True = initialize SPI bus if not already initialized, False = do not initialize SPI bus, assumes already initialized.
          * @param VCC Float, VCC for the EEPROM, determines clock speed, defaults to 3.3v.
          * @return int16_t Returns 0 if initialized okay, negative for error code.
          */
@@ -311,6 +371,7 @@ class my25xx640A {
         const uint8_t STATE_IDLE_VALUE      = 0x00; // 0b ---- --00
         const uint8_t STATE_READ_VALUE      = 0x01; // 0b ---- --01
         const uint8_t STATE_WRITE_VALUE     = 0x02; // 0b ---- --10
+        const uint8_t STATE_CYCLE_VALUE     = 0x03; // 0b ---- --11
         const uint8_t STATE_HELD_MASK       = 0x04; // 0b ---- -1--
         const uint8_t STATE_WP_MASK         = 0x08; // 0b ---- 1---
     //Pins:
@@ -326,10 +387,23 @@ class my25xx640A {
     // State:
         bool _haveHold = false;
         bool _haveWP = false;
-        uint8_t _state = 0x00;
+        volatile uint8_t _state = 0x00;
         int16_t _address = 0x0000;
         uint8_t _block = 0x00;
+        int16_t _profileId = -1;    // mySPI profile.
+    // Background write:
+        writeCallback_t _writeCallback = nullptr;
+        void *_writeUserData = nullptr;
+        uint32_t _cycleStartUs = 0;
+        uint32_t _lastPollUs = 0;
+        repeating_timer_t _pollTimer;
+        volatile bool _timerPolling = false; // The poll timer runs the cycle, not isWriteBusy().
+        bool _inPollTimer = false; // In the timer's callback, a new cycle reuses the timer.
+        int16_t _writeStatus = NO_ERROR; // Status of the last cycle, until waitWrite() reports it.
 /* ############### Private Functions: ############# */
+    // Chip select functions:
+        inline void __selectChip__();   // Select our profile and lower cs.
+        inline void __deselectChip__(); // Raise cs.
     // State functions:
         inline bool __isIdle__();      // Check read write bits = Idle.
         inline void __setIdle__();     // Set read write bits to idle.
@@ -337,14 +411,22 @@ class my25xx640A {
         inline void __setReading__();  // Set read write bits to reading.
         inline bool __isWriting__();   // Check read write bits = writing.
         inline void __setWriting__();  // Set read write bits to writing.
+        inline bool __isCycling__();   // Check read write bits = background write cycle.
+        inline void __setCycling__();  // Set read write bits to background write cycle.
         inline bool __isHeld__();      // Check Hold bit.
         inline void __setHold__(const bool value); // Set / clear hold bit.
         inline bool __isWriteProtect__(); // Check write protect bit.
         inline void __setWriteProtect__(const bool value); // Set / clear write protect bit.
         inline int16_t __incAddress__(); // Increment the stored address.
+        inline void __advanceAddress__(const size_t count); // Advance the stored address by count, wrapping at max address.
         int16_t __calculateNextBoundary__(); // Use _address to calculate the next boundary.
         uint8_t __readByte__(); // Read and return a single byte.
-        void __writeByte__(const uint8_t value); // Write a single byte, and restart write if boundary crossed. Increments address.
+        int16_t __writeByte__(const uint8_t value); // Write a single byte, and restart write if boundary crossed. Increments address.
+        int16_t __writePage__(const uint8_t *data, const size_t len); // Write bytes within one page, and restart write if boundary reached. Advances address.
+        int16_t __waitWriteCycle__(); // Poll WIP until the write cycle is done, or twice the write time has passed.
+        int16_t __pollWriteCycle__(); // Read WIP once, returns 1 while cycling, else the cycle's status.
+        void __endWriteCycle__(const int16_t status); // End a background write, and call its callback.
+        static bool __pollTimer__(repeating_timer_t *timer); // Timer callback, polls WIP when the port is free.
         uint8_t __readStatus__(); // Read and return the status byte.
         void __writeStatus__(const uint8_t value); // Write the status register to value.
 
@@ -382,13 +464,14 @@ bool my25xx640A::isAddressWriteProtected(const int16_t address) {
 int16_t my25xx640A::startRead(const int16_t address) {
     uint8_t dataBuffer[3];
     if (isValidAddress(address) == false) { return ERROR_INVALID_ADDRESS; }
+    if (isWriteBusy() == true) { return ERROR_BUSY; }
     if (__isIdle__() == false) { return ERROR_BUSY; }
     if (__isHeld__() == true) { return ERROR_HELD; }
     dataBuffer[0] = CMD_READ;
     dataBuffer[1] = uint8_t(address >> 8);
     dataBuffer[2] = uint8_t(address);
-    gpio_put(_csPin, false);
-    spi_write_blocking(_spiPort, dataBuffer, 3);
+    __selectChip__();
+    mySPI::write_blocking(_spiPort, dataBuffer, 3);
     _address = address;
     __setReading__();
     return NO_ERROR;
@@ -397,10 +480,8 @@ int16_t my25xx640A::startRead(const int16_t address) {
 int16_t my25xx640A::read(uint8_t *recvBuffer, size_t len) {
     if (__isReading__() == false) { return ERROR_NOT_READING; }
     if (__isHeld__() == true) { return ERROR_HELD; }
-    for (size_t i=0; i<len; i++) {
-        recvBuffer[i] = __readByte__();
-        __incAddress__();
-    }
+    mySPI::read_dma_blocking(_spiPort, 0x00, recvBuffer, len);
+    __advanceAddress__(len);
     return NO_ERROR;
 }
 
@@ -415,29 +496,34 @@ int16_t my25xx640A::readByte() {
 int16_t my25xx640A::startWrite(const int16_t address) {
     uint8_t dataBuffer[3];
     if (isValidAddress(address) == false) { return ERROR_INVALID_ADDRESS; }
+    if (isWriteBusy() == true) { return ERROR_BUSY; }
     if (__isIdle__() == false) { return ERROR_BUSY; }
     if (__isHeld__() == true) { return ERROR_HELD; }
     if (isAddressWriteProtected(_address) == true) { return ERROR_WRITE_PROTECTED; }
-    gpio_put(_csPin, false);
-    spi_write_blocking(_spiPort, &CMD_WREN, 1);
-    gpio_put(_csPin, true);
+    __selectChip__();
+    mySPI::write_blocking(_spiPort, &CMD_WREN, 1);
+    __deselectChip__();
     dataBuffer[0] = CMD_WRITE;
     dataBuffer[1] = uint8_t(address >> 8);
     dataBuffer[2] = uint8_t(address);
-    gpio_put(_csPin, false);
-    spi_write_blocking(_spiPort, dataBuffer, 3);
+    __selectChip__();
+    mySPI::write_blocking(_spiPort, dataBuffer, 3);
     _address = address;
     __setWriting__();
     return NO_ERROR;
 }
 
 int16_t my25xx640A::write(const uint8_t *sendBuffer, size_t len) {
-    uint8_t pageBuffer[PAGE_SIZE];
     if (__isWriting__() == false) { return ERROR_NOT_WRITING; }
     if (__isHeld__() == true) { return ERROR_HELD; }
-    for (size_t i=0; i<len; i++) {
+    size_t done = 0;
+    while (done < len) {
+        const size_t chunk = MIN(len - done, (size_t)(PAGE_SIZE - (_address % PAGE_SIZE)));
+    // Protected blocks start on page boundaries, so the first byte covers the page:
         if (isAddressWriteProtected(_address) == true) { return ERROR_WRITE_PROTECTED; }
-        __writeByte__(sendBuffer[i]);
+        const int16_t returnValue = __writePage__(&sendBuffer[done], chunk);
+        if (returnValue < 0) { return returnValue; }
+        done += chunk;
     }
     return NO_ERROR;
 }
@@ -446,19 +532,73 @@ int16_t my25xx640A::writeByte(const uint8_t value) {
     if (__isWriting__() == false) { return ERROR_NOT_WRITING; }
     if (__isHeld__() == true) { return ERROR_HELD; }
     if (isAddressWriteProtected(_address) == true) { return ERROR_WRITE_PROTECTED; }
-    __writeByte__(value);
-    return NO_ERROR;
+    return __writeByte__(value);
 }
 
 int16_t my25xx640A::stop() {
     if (__isIdle__() == true) { return ERROR_IDLE; }
+    if (__isCycling__() == true) { return ERROR_BUSY; }
     if (__isHeld__() == true) { return ERROR_HELD; }
-    gpio_put(_csPin, true);
+    __deselectChip__();
+    int16_t returnValue = NO_ERROR;
     if (__isWriting__() == true) {
-        sleep_ms(WRITE_TIME_MS);
+        returnValue = __waitWriteCycle__();
     }
     __setIdle__();
-    return NO_ERROR;
+    return returnValue;
+}
+
+int16_t my25xx640A::writePageAsync(const int16_t address, const uint8_t *sendBuffer, size_t len,
+                                        writeCallback_t callback, void *userData) {
+    uint8_t dataBuffer[3];
+    if (isValidAddress(address) == false) { return ERROR_INVALID_ADDRESS; }
+    if (isWriteBusy() == true) { return ERROR_BUSY; }
+    if (__isIdle__() == false) { return ERROR_BUSY; }
+    if (__isHeld__() == true) { return ERROR_HELD; }
+    if (isAddressWriteProtected(address) == true) { return ERROR_WRITE_PROTECTED; }
+    const size_t chunk = MIN(len, (size_t)(PAGE_SIZE - (address % PAGE_SIZE)));
+    if (chunk == 0) { return 0; }
+    __selectChip__();
+    mySPI::write_blocking(_spiPort, &CMD_WREN, 1);
+    __deselectChip__();
+    dataBuffer[0] = CMD_WRITE;
+    dataBuffer[1] = uint8_t(address >> 8);
+    dataBuffer[2] = uint8_t(address);
+    __selectChip__();
+    mySPI::write_blocking(_spiPort, dataBuffer, 3);
+    mySPI::write_dma_blocking(_spiPort, sendBuffer, chunk);
+    __deselectChip__();
+    _address = address;
+    __advanceAddress__(chunk);
+    _writeCallback = callback;
+    _writeUserData = userData;
+    _cycleStartUs = time_us_32();
+    _lastPollUs = _cycleStartUs;
+    __setCycling__();
+    if (_inPollTimer == true) {
+        _timerPolling = true;
+    } else {
+        _timerPolling = add_repeating_timer_us(-(int64_t)MY_25XX640A_POLL_US, __pollTimer__, this, &_pollTimer);
+    }
+    return (int16_t)chunk;
+}
+
+bool my25xx640A::isWriteBusy() {
+    if (__isCycling__() == false) { return false; }
+    if (_timerPolling == true or __isHeld__() == true) { return true; }
+    const uint32_t now = time_us_32();
+    if ((now - _lastPollUs) < MY_25XX640A_POLL_US) { return true; }
+    _lastPollUs = now;
+    const int16_t status = __pollWriteCycle__();
+    if (status <= 0) { __endWriteCycle__(status); }
+    return __isCycling__();
+}
+
+int16_t my25xx640A::waitWrite() {
+    while (isWriteBusy() == true) { tight_loop_contents(); }
+    const int16_t status = _writeStatus;
+    _writeStatus = NO_ERROR;
+    return status;
 }
 
 int16_t my25xx640A::setHold() {
@@ -482,6 +622,7 @@ int16_t my25xx640A::clearHold() {
 int16_t my25xx640A::setWriteProtectBlock(const uint8_t block) {
     uint8_t status;
     if (isValidBlock(block) == false) { return ERROR_INVALID_BLOCK; }
+    if (isWriteBusy() == true) { return ERROR_BUSY; }
     if (__isIdle__() == false) { return ERROR_BUSY; }
     if (__isWriteProtect__() == true) { return ERROR_WRITE_PROTECTED; }
     status = __readStatus__();
@@ -495,6 +636,7 @@ int16_t my25xx640A::setWriteProtectBlock(const uint8_t block) {
 int16_t my25xx640A::setWriteProtect() {
     uint8_t status;
     if (__isWriteProtect__() == true) { return ERROR_WRITE_PROTECTED; }
+    if (isWriteBusy() == true) { return ERROR_BUSY; }
     if (__isIdle__() == false) { return ERROR_BUSY; }
     status = __readStatus__();
     status |= STATUS_WPEN_MASK;
@@ -508,6 +650,7 @@ int16_t my25xx640A::setWriteProtect() {
 
 int16_t my25xx640A::clearWriteProtect() {
     uint8_t status;
+    if (isWriteBusy() == true) { return ERROR_BUSY; }
     if (__isIdle__() == false) { return ERROR_BUSY; }
     if (__isWriteProtect__() == false) { return ERROR_NOT_WRITE_PROTECTED; }
     if (_haveWP == true) {
@@ -525,42 +668,48 @@ template <typename T> int32_t my25xx640A::writeAnything(const T &value) {
     int32_t i;
     if (__isWriting__() == false) { return ERROR_NOT_WRITING; }
     if (__isHeld__() == true) { return ERROR_HELD; }
-    for (i=0; i<sizeof(value); i++) {
+    for (i=0; i<sizeof(value); ) {
+        const int32_t chunk = MIN((int32_t)sizeof(value) - i, (int32_t)(PAGE_SIZE - (_address % PAGE_SIZE)));
         if (isAddressWriteProtected(_address) == true) { return ERROR_WRITE_PROTECTED; }
-        __writeByte__(*p++);
+        const int16_t returnValue = __writePage__(p, chunk);
+        if (returnValue < 0) { return returnValue; }
+        p += chunk;
+        i += chunk;
     }
     return i;
 }
 
 template <typename T> int32_t my25xx640A::readAnything( T &value) {
-    uint8_t *p = (uint8_t *)&value;
-    int32_t i;
-    if (__isReading__() == false) { return ERROR_NOT_READING; }
-    if (__isHeld__() == true) { return ERROR_HELD; }
-    for (i=0; i<sizeof(value); i++) {
-        if (isAddressWriteProtected(_address) == true) { return ERROR_WRITE_PROTECTED; }
-        *p++ = __readByte__();
-    }
-    return i;
+    int16_t returnValue = read((uint8_t *)&value, sizeof(value));
+    if (returnValue < 0) { return returnValue; }
+    return sizeof(value);
 }
 
 int16_t my25xx640A::initialize(const bool initSPI, const float VCC) {
     int32_t returnValue;
-    if (initSPI == true) {
-        uint32_t baudRate;
-        if (VCC >= 4.5f) {
-            baudRate = 10000 * 1000; // 10 MHz.
-        } else if (VCC >= 2.5f) {
-            baudRate = 5000 * 1000; // 5 MHz.
-        } else {
-            baudRate = 3000 * 1000; // 3 MHz.
-        }
+    uint32_t baudRate;
+    if (VCC >= 4.5f) {
+        baudRate = 10000 * 1000; // 10 MHz.
+    } else if (VCC >= 2.5f) {
+        baudRate = 5000 * 1000; // 5 MHz.
+    } else {
+        baudRate = 3000 * 1000; // 3 MHz.
+    }
+    if (initSPI == true and mySPI::getPortInit(_spiPort) == false) {
         returnValue = mySPI::initializeMaster(_spiPort, _sckPin, _misoPin, _mosiPin, baudRate);
         if (returnValue < 0) { return (int16_t)returnValue; }
     }
 // Init gpio pins:
     // cs Pin.
     if (myHelpers::isPin(_csPin) == false) { return ERROR_INVALID_CS_PIN; }
+    if (_profileId < 0) {
+        mySPI::profile_t profile;
+        profile.baudRate = baudRate;
+        profile.csPin = _csPin;
+        returnValue = mySPI::registerProfile(_spiPort, profile);
+        if (returnValue < 0) { return (int16_t)returnValue; }
+        _profileId = (int16_t)returnValue;
+    }
     gpio_init(_csPin);
     gpio_set_dir(_csPin, GPIO_OUT);
     gpio_put(_csPin, true);
@@ -580,6 +729,15 @@ int16_t my25xx640A::initialize(const bool initSPI, const float VCC) {
 }
 
 /* ############## Private Functions: #################### */
+inline void my25xx640A::__selectChip__() {
+    mySPI::selectProfile(_spiPort, _profileId);
+    gpio_put(_csPin, false);
+}
+
+inline void my25xx640A::__deselectChip__() {
+    gpio_put(_csPin, true);
+}
+
 inline bool my25xx640A::__isIdle__() {
     return ((_state & STATE_READ_WRITE_MASK) == STATE_IDLE_VALUE);
 }
@@ -606,6 +764,14 @@ inline void my25xx640A::__setWriting__() {
     _state |= STATE_WRITE_VALUE;
 }
 
+inline bool my25xx640A::__isCycling__() {
+    return ((_state & STATE_READ_WRITE_MASK) == STATE_CYCLE_VALUE);
+}
+
+inline void my25xx640A::__setCycling__() {
+    _state |= STATE_CYCLE_VALUE;
+}
+
 inline bool my25xx640A::__isHeld__() {
     return bool(_state & STATE_HELD_MASK);
 }
@@ -636,50 +802,101 @@ inline int16_t my25xx640A::__incAddress__() {
     return returnValue;
 }
 
+inline void my25xx640A::__advanceAddress__(const size_t count) {
+    _address = (int16_t)((_address + count) % (MAX_ADDRESS + 1));
+}
+
 int16_t my25xx640A::__calculateNextBoundary__() {
     return (_address + (PAGE_SIZE - (_address % PAGE_SIZE) -1));
 }
 
 uint8_t my25xx640A::__readByte__() {
     uint8_t value;
-    spi_read_blocking(_spiPort, 0x00, &value, 1);
+    mySPI::read_blocking(_spiPort, 0x00, &value, 1);
     return value;
 }
 
-void my25xx640A::__writeByte__(const uint8_t value) {
+int16_t my25xx640A::__writeByte__(const uint8_t value) {
+    return __writePage__(&value, 1);
+}
+
+int16_t my25xx640A::__writePage__(const uint8_t *data, const size_t len) {
     uint8_t addressBuffer[3];
-    spi_write_blocking(_spiPort, &value, 1);
     int16_t boundary = __calculateNextBoundary__();
-    if (_address == boundary) {
-        gpio_put(_csPin, true);
-        sleep_ms(WRITE_TIME_MS);
-        gpio_put(_csPin, false);
-        spi_write_blocking(_spiPort, &CMD_WREN, 1);
-        gpio_put(_csPin, true);
-        __incAddress__();
+    mySPI::write_dma_blocking(_spiPort, data, len);
+    if (_address + (int16_t)len - 1 == boundary) {
+        __deselectChip__();
+    // The chip is deselected, so a timed out write is over:
+        if (__waitWriteCycle__() == ERROR_TIMEOUT) {
+            __setIdle__();
+            return ERROR_TIMEOUT;
+        }
+        __selectChip__();
+        mySPI::write_blocking(_spiPort, &CMD_WREN, 1);
+        __deselectChip__();
+        __advanceAddress__(len);
         addressBuffer[0] = CMD_WRITE;
         addressBuffer[1] = uint8_t(_address >> 8);
         addressBuffer[2] = uint8_t(_address);
-        gpio_put(_csPin, false);
-        spi_write_blocking(_spiPort, addressBuffer, 3);
+        __selectChip__();
+        mySPI::write_blocking(_spiPort, addressBuffer, 3);
     } else {
-        __incAddress__();
+        __advanceAddress__(len);
     }
+    return NO_ERROR;
+}
+
+int16_t my25xx640A::__waitWriteCycle__() {
+// The cycle is done by WRITE_TIME_MS at worst, give up at twice that in case the chip is gone:
+    const uint32_t startTime = time_us_32();
+    while ((__readStatus__() & STATUS_WIP_MASK) != 0) {
+        if ((time_us_32() - startTime) >= (2u * WRITE_TIME_MS * 1000u)) { return ERROR_TIMEOUT; }
+    }
+    return NO_ERROR;
+}
+
+int16_t my25xx640A::__pollWriteCycle__() {
+// The cycle is done by WRITE_TIME_MS at worst, give up at twice that in case the chip is gone:
+    if ((__readStatus__() & STATUS_WIP_MASK) == 0) { return NO_ERROR; }
+    if ((time_us_32() - _cycleStartUs) >= (2u * WRITE_TIME_MS * 1000u)) { return ERROR_TIMEOUT; }
+    return 1;
+}
+
+bool my25xx640A::__pollTimer__(repeating_timer_t *timer) {
+    my25xx640A *eeprom = (my25xx640A *)timer->user_data;
+// Leave an owned port to its owner, and try again next tick:
+    if (eeprom->__isHeld__() == true) { return true; }
+    if (mySPI::__tryClaimPort__(eeprom->_spiPort, mySPI::OWNER_TIMER) == false) { return true; }
+    const int16_t status = eeprom->__pollWriteCycle__();
+    mySPI::__unclaimPort__(eeprom->_spiPort, mySPI::OWNER_TIMER);
+    if (status > 0) { return true; }
+    eeprom->_timerPolling = false;
+// The callback may start the next page, which keeps this timer running:
+    eeprom->_inPollTimer = true;
+    eeprom->__endWriteCycle__(status);
+    eeprom->_inPollTimer = false;
+    return eeprom->_timerPolling;
+}
+
+void my25xx640A::__endWriteCycle__(const int16_t status) {
+    __setIdle__();
+    if (status < 0) { _writeStatus = status; }
+    if (_writeCallback != nullptr) { _writeCallback(this, status, _writeUserData); }
 }
 
 uint8_t my25xx640A::__readStatus__() {
     uint8_t status;
-    gpio_put(_csPin, false);
-    spi_write_blocking(_spiPort, &CMD_RDSR, 1);
-    spi_read_blocking(_spiPort, 0x00, &status, 1);
-    gpio_put(_csPin, true);
+    __selectChip__();
+    mySPI::write_blocking(_spiPort, &CMD_RDSR, 1);
+    mySPI::read_blocking(_spiPort, 0x00, &status, 1);
+    __deselectChip__();
     return status;
 }
 
 void my25xx640A::__writeStatus__(const uint8_t value) {
-    gpio_put(_csPin, false);
-    spi_write_blocking(_spiPort, &CMD_WRSR, 1);
-    spi_write_blocking(_spiPort, &value, 1);
-    gpio_put(_csPin, true);
+    __selectChip__();
+    mySPI::write_blocking(_spiPort, &CMD_WRSR, 1);
+    mySPI::write_blocking(_spiPort, &value, 1);
+    __deselectChip__();
 }
 #endif
\ No newline at end of file
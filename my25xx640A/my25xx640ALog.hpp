@@ -0,0 +1,391 @@
+/**
+ * @file my25xx640ALog.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Append only record log on the 25xx640A.
+ * @version 0.1
+ * @date 2022-08-10
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY_25xx640A_LOG_H
+#define MY_25xx640A_LOG_H
+
+#include "../myStandardDefines.hpp"
+#include "../myErrorCodes.hpp"
+#include "../myHelpers.hpp"
+#include "my25xx640A.hpp"
+/**
+ * @brief Append only record log on the 25xx640A.
+ * Keyed records are appended to a ring of pages rather than rewritten in place. Records are
+ * gathered in a RAM copy of the open page, which is written in one page write when the next
+ * record doesn't fit, or on flush(). Each page starts with a 16 bit sequence number, and each
+ * record carries its key, length and a CRC-16. mount() rebuilds a RAM index of the latest
+ * record for each key with one read of the whole log, so lookups are a single read. When the
+ * ring is full, the oldest page is reused, and its still latest records are carried into the
+ * new page.
+ * @note Page writes run in the background through my25xx640A::writePageAsync(), the EEPROM must
+ * only be used through the log while it's mounted. A page torn by power loss loses its records
+ * from the first bad CRC on, which can include records being carried out of the oldest page.
+ */
+class my25xx640ALog {
+
+    public:
+/* ################### Constants: ################# */
+        /**
+         * @brief Number of keys, keys run from 0 to MAX_KEYS - 1.
+         */
+        static const uint8_t MAX_KEYS = MY_25XX640A_LOG_MAX_KEYS;
+        /**
+         * @brief Size of the page header, the sequence number.
+         */
+        static const int16_t PAGE_HEADER_SIZE = 2;
+        /**
+         * @brief Size of a record header, key, length and CRC.
+         */
+        static const int16_t RECORD_HEADER_SIZE = 4;
+        /**
+         * @brief Longest record data that fits in a page.
+         */
+        static const int16_t MAX_RECORD_LENGTH = my25xx640A::PAGE_SIZE - PAGE_HEADER_SIZE - RECORD_HEADER_SIZE;
+        /**
+         * @brief Number of pages on the EEPROM.
+         */
+        static const int16_t NUM_PAGES = (my25xx640A::MAX_ADDRESS + 1) / my25xx640A::PAGE_SIZE;
+    // Error codes:
+        /**
+         * @brief No error. Value 0.
+         */
+        static const int16_t NO_ERROR = MY_NO_ERROR;
+        /**
+         * @brief Log not mounted. Value -336.
+         * The log was used before mount() or format().
+         */
+        static const int16_t ERROR_NOT_MOUNTED = MY_ERROR_MY25xx640A_LOG_NOT_MOUNTED;
+        /**
+         * @brief Invalid key. Value -337.
+         * The key is MAX_KEYS or more.
+         */
+        static const int16_t ERROR_INVALID_KEY = MY_ERROR_MY25xx640A_LOG_INVALID_KEY;
+        /**
+         * @brief Invalid length. Value -338.
+         * The record is longer than MAX_RECORD_LENGTH.
+         */
+        static const int16_t ERROR_INVALID_LENGTH = MY_ERROR_MY25xx640A_LOG_INVALID_LENGTH;
+        /**
+         * @brief Key not found. Value -339.
+         * No record has been logged for the key.
+         */
+        static const int16_t ERROR_KEY_NOT_FOUND = MY_ERROR_MY25xx640A_LOG_KEY_NOT_FOUND;
+        /**
+         * @brief CRC mismatch. Value -340.
+         * The record read back doesn't match its CRC.
+         */
+        static const int16_t ERROR_CRC = MY_ERROR_MY25xx640A_LOG_CRC;
+        /**
+         * @brief Log full. Value -341.
+         * Every page holds latest records, so there's no room to reclaim.
+         */
+        static const int16_t ERROR_LOG_FULL = MY_ERROR_MY25xx640A_LOG_FULL;
+/* ################## Constructor: ################ */
+        /**
+         * @brief Construct a new my25xx640ALog object.
+         * @param eeprom Initialized EEPROM to hold the log.
+         * @param firstPage First page of the log. Defaults to 0.
+         * @param numPages Number of pages in the log, cut to what fits. Defaults to the whole EEPROM.
+         */
+        my25xx640ALog(my25xx640A &eeprom, const int16_t firstPage=0, const int16_t numPages=NUM_PAGES);
+/* ################ Public functions: ############## */
+        /**
+         * @brief Erase the log and mount it empty.
+         * Writes every page of the log blank, one page write each.
+         * @return int16_t Returns 0 (NO_ERROR) if formatted, negative for error code.
+         */
+        int16_t format();
+        /**
+         * @brief Mount the log.
+         * Reads the whole log in one read, finds the newest page, and rebuilds the index.
+         * @return int16_t Returns 0 (NO_ERROR) if mounted, negative for error code.
+         */
+        int16_t mount();
+        /**
+         * @brief Append a record.
+         * The record is kept in the open page, which goes to the EEPROM once full, or on flush().
+         * @param key Record key, 0 to MAX_KEYS - 1.
+         * @param data Record data.
+         * @param length Length of data, 0 to MAX_RECORD_LENGTH.
+         * @return int16_t Returns 0 (NO_ERROR) if appended, negative for error code.
+         */
+        int16_t append(const uint8_t key, const uint8_t *data, const uint8_t length);
+        /**
+         * @brief Read the latest record for a key.
+         * @param key Record key.
+         * @param buffer Buffer for the data.
+         * @param maxLength Size of buffer, longer records are cut to fit.
+         * @return int16_t Returns the record length, negative for error code.
+         */
+        int16_t read(const uint8_t key, uint8_t *buffer, const uint8_t maxLength);
+        /**
+         * @brief Check for a record.
+         * @param key Record key.
+         * @return true A record is logged for key.
+         * @return false No record is logged for key, or key is invalid.
+         */
+        bool contains(const uint8_t key);
+        /**
+         * @brief Write the open page, and wait for the write cycle.
+         * A page write that timed out is reported by the next call that waits on the EEPROM, with
+         * my25xx640A::ERROR_TIMEOUT.
+         * @return int16_t Returns 0 (NO_ERROR) if flushed, negative for error code.
+         */
+        int16_t flush();
+        /**
+         * @brief Get the number of pages not holding records.
+         * @return int16_t Free pages, not counting the open page.
+         */
+        int16_t getFreePages();
+
+    private:
+/* ################ Private variables: ############### */
+        my25xx640A &_eeprom;
+        int16_t _firstPage;
+        int16_t _numPages;
+        bool _mounted = false;
+        int16_t _index[MAX_KEYS];                       // Address of the latest record per key, -1 for none.
+        int16_t _open = 0;                              // Page being filled, kept in _stage.
+        int16_t _used = 0;                              // Pages in use, the open page included.
+        uint16_t _seq = 0;                              // Sequence number of the open page.
+        uint8_t _stage[my25xx640A::PAGE_SIZE];
+        int16_t _stageLength = 0;
+        bool _stageDirty = false;
+/* ################ Private functions: ############### */
+        int16_t __pageAddress__(const int16_t page);
+        int16_t __recordLength__(const uint8_t *page, const int16_t offset);   // Length of a valid record at offset, 0 at the end.
+        void __startStage__(const int16_t page);                               // Empty stage for page, with the next sequence number.
+        void __addToStage__(const uint8_t *record, const int16_t length);      // Append a record to the stage, and index it.
+        int16_t __writeStage__();
+        int16_t __nextPage__();                                                 // Close the open page and open the next, reclaiming if full.
+};
+
+/* ################## Constructor: ################### */
+my25xx640ALog::my25xx640ALog(my25xx640A &eeprom, const int16_t firstPage, const int16_t numPages) : _eeprom (eeprom) {
+    _firstPage = MIN(MAX(firstPage, 0), NUM_PAGES - 1);
+    _numPages = MIN(MAX(numPages, 1), NUM_PAGES - _firstPage);
+}
+
+/* ################## Public functions: ################## */
+int16_t my25xx640ALog::format() {
+    uint8_t blank[my25xx640A::PAGE_SIZE];
+    memset(blank, 0xFF, sizeof(blank));
+    _mounted = false;
+    int16_t returnValue;
+    for (int16_t page=0; page<_numPages; page++) {
+        returnValue = _eeprom.waitWrite();
+        if (returnValue < 0) { return returnValue; }
+        returnValue = _eeprom.writePageAsync(__pageAddress__(page), blank, sizeof(blank));
+        if (returnValue < 0) { return returnValue; }
+    }
+    returnValue = _eeprom.waitWrite();
+    if (returnValue < 0) { return returnValue; }
+    return mount();
+}
+
+int16_t my25xx640ALog::mount() {
+    uint8_t page[my25xx640A::PAGE_SIZE];
+    uint16_t keySeqs[MAX_KEYS];
+    int16_t newest = -1;
+    uint16_t newestSeq = 0;
+    _mounted = false;
+    _used = 0;
+    for (uint8_t i=0; i<MAX_KEYS; i++) { _index[i] = -1; }
+    int16_t returnValue = _eeprom.waitWrite();
+    if (returnValue < 0) { return returnValue; }
+    returnValue = _eeprom.startRead(__pageAddress__(0));
+    if (returnValue < 0) { return returnValue; }
+    for (int16_t p=0; p<_numPages; p++) {
+        returnValue = _eeprom.read(page, sizeof(page));
+        if (returnValue < 0) {
+            _eeprom.stop();
+            return returnValue;
+        }
+        const uint16_t seq = ((uint16_t)page[0] << 8) | page[1];
+        if (seq == 0xFFFF) { continue; }               // Blank page.
+        _used++;
+    // Newest by serial number order, the ring is far shorter than half the sequence space:
+        if (newest < 0 or (int16_t)(seq - newestSeq) > 0) {
+            newest = p;
+            newestSeq = seq;
+            memcpy(_stage, page, sizeof(page));
+        }
+    // Later records win, later in a page or in a newer page:
+        int16_t offset = PAGE_HEADER_SIZE;
+        int16_t length;
+        while ((length = __recordLength__(page, offset)) > 0) {
+            const uint8_t key = page[offset];
+            if (key < MAX_KEYS and (_index[key] < 0 or (int16_t)(seq - keySeqs[key]) >= 0)) {
+                _index[key] = __pageAddress__(p) + offset;
+                keySeqs[key] = seq;
+            }
+            offset += length;
+        }
+    }
+    _eeprom.stop();
+    if (newest < 0) {
+        _used = 1;
+        _seq = 0xFFFF;
+        __startStage__(0);
+    } else {
+    // Pages are written in ring order, so the newest is the one to carry on filling:
+        _open = newest;
+        _seq = newestSeq;
+        _stageLength = PAGE_HEADER_SIZE;
+        int16_t length;
+        while ((length = __recordLength__(_stage, _stageLength)) > 0) { _stageLength += length; }
+        memset(&_stage[_stageLength], 0xFF, sizeof(_stage) - _stageLength);
+        _stageDirty = false;
+    }
+    _mounted = true;
+    return NO_ERROR;
+}
+
+int16_t my25xx640ALog::append(const uint8_t key, const uint8_t *data, const uint8_t length) {
+    uint8_t record[my25xx640A::PAGE_SIZE];
+    if (_mounted == false) { return ERROR_NOT_MOUNTED; }
+    if (key >= MAX_KEYS) { return ERROR_INVALID_KEY; }
+    if (length > MAX_RECORD_LENGTH) { return ERROR_INVALID_LENGTH; }
+    const int16_t recordLength = RECORD_HEADER_SIZE + length;
+    record[0] = key;
+    record[1] = length;
+    uint16_t crc = myHelpers::crc16(record, 2);
+    crc = myHelpers::crc16(data, length, crc);
+    record[2] = uint8_t(crc >> 8);
+    record[3] = uint8_t(crc);
+    memcpy(&record[RECORD_HEADER_SIZE], data, length);
+// Each new page can carry up to a page of live records, so give up after going round once:
+    int16_t tries = 0;
+    while (_stageLength + recordLength > my25xx640A::PAGE_SIZE) {
+        if (tries++ > _numPages) { return ERROR_LOG_FULL; }
+        int16_t returnValue = __nextPage__();
+        if (returnValue < 0) { return returnValue; }
+    }
+    __addToStage__(record, recordLength);
+    return NO_ERROR;
+}
+
+int16_t my25xx640ALog::read(const uint8_t key, uint8_t *buffer, const uint8_t maxLength) {
+    uint8_t record[my25xx640A::PAGE_SIZE];
+    if (_mounted == false) { return ERROR_NOT_MOUNTED; }
+    if (key >= MAX_KEYS) { return ERROR_INVALID_KEY; }
+    const int16_t address = _index[key];
+    if (address < 0) { return ERROR_KEY_NOT_FOUND; }
+    const int16_t offset = address % my25xx640A::PAGE_SIZE;
+    if (address - offset == __pageAddress__(_open)) {
+        memcpy(record, &_stage[offset], my25xx640A::PAGE_SIZE - offset);
+    } else {
+        int16_t returnValue = _eeprom.waitWrite();
+        if (returnValue < 0) { return returnValue; }
+        returnValue = _eeprom.startRead(address);
+        if (returnValue < 0) { return returnValue; }
+        returnValue = _eeprom.read(record, my25xx640A::PAGE_SIZE - offset);
+        _eeprom.stop();
+        if (returnValue < 0) { return returnValue; }
+    }
+    const uint8_t length = record[1];
+    if (record[0] != key or length > MAX_RECORD_LENGTH) { return ERROR_CRC; }
+    uint16_t crc = myHelpers::crc16(record, 2);
+    crc = myHelpers::crc16(&record[RECORD_HEADER_SIZE], length, crc);
+    if (crc != (((uint16_t)record[2] << 8) | record[3])) { return ERROR_CRC; }
+    memcpy(buffer, &record[RECORD_HEADER_SIZE], MIN(length, maxLength));
+    return length;
+}
+
+bool my25xx640ALog::contains(const uint8_t key) {
+    if (_mounted == false or key >= MAX_KEYS) { return false; }
+    return (_index[key] >= 0);
+}
+
+int16_t my25xx640ALog::flush() {
+    if (_mounted == false) { return ERROR_NOT_MOUNTED; }
+    int16_t returnValue = __writeStage__();
+    if (returnValue < 0) { return returnValue; }
+    return _eeprom.waitWrite();
+}
+
+int16_t my25xx640ALog::getFreePages() {
+    if (_mounted == false) { return ERROR_NOT_MOUNTED; }
+    return _numPages - _used;
+}
+
+/* ################## Private functions: ################# */
+int16_t my25xx640ALog::__pageAddress__(const int16_t page) {
+    return (_firstPage + page) * my25xx640A::PAGE_SIZE;
+}
+
+int16_t my25xx640ALog::__recordLength__(const uint8_t *page, const int16_t offset) {
+    if (offset + RECORD_HEADER_SIZE > my25xx640A::PAGE_SIZE) { return 0; }
+    if (page[offset] == 0xFF) { return 0; }             // Blank, end of the page.
+    const uint8_t length = page[offset + 1];
+    if (offset + RECORD_HEADER_SIZE + length > my25xx640A::PAGE_SIZE) { return 0; }
+    uint16_t crc = myHelpers::crc16(&page[offset], 2);
+    crc = myHelpers::crc16(&page[offset + RECORD_HEADER_SIZE], length, crc);
+    if (crc != (((uint16_t)page[offset + 2] << 8) | page[offset + 3])) { return 0; }
+    return RECORD_HEADER_SIZE + length;
+}
+
+void my25xx640ALog::__startStage__(const int16_t page) {
+    _seq++;
+    if (_seq == 0xFFFF) { _seq = 0; }                   // 0xFFFF marks a blank page.
+    _open = page;
+    memset(_stage, 0xFF, sizeof(_stage));
+    _stage[0] = uint8_t(_seq >> 8);
+    _stage[1] = uint8_t(_seq);
+    _stageLength = PAGE_HEADER_SIZE;
+    _stageDirty = false;
+}
+
+void my25xx640ALog::__addToStage__(const uint8_t *record, const int16_t length) {
+    memcpy(&_stage[_stageLength], record, length);
+    _index[record[0]] = __pageAddress__(_open) + _stageLength;
+    _stageLength += length;
+    _stageDirty = true;
+}
+
+int16_t my25xx640ALog::__writeStage__() {
+    if (_stageDirty == false) { return NO_ERROR; }
+    int16_t returnValue = _eeprom.waitWrite();
+    if (returnValue < 0) { return returnValue; }
+    returnValue = _eeprom.writePageAsync(__pageAddress__(_open), _stage, sizeof(_stage));
+    if (returnValue < 0) { return returnValue; }
+    _stageDirty = false;
+    return NO_ERROR;
+}
+
+int16_t my25xx640ALog::__nextPage__() {
+    uint8_t oldest[my25xx640A::PAGE_SIZE];
+    int16_t returnValue = __writeStage__();
+    if (returnValue < 0) { return returnValue; }
+    const int16_t next = (_open + 1) % _numPages;
+    if (_used < _numPages) {
+        __startStage__(next);
+        _used++;
+        return NO_ERROR;
+    }
+// Full, so next is the oldest page. Read it before reusing it, and carry its latest records:
+    returnValue = _eeprom.waitWrite();
+    if (returnValue < 0) { return returnValue; }
+    returnValue = _eeprom.startRead(__pageAddress__(next));
+    if (returnValue < 0) { return returnValue; }
+    returnValue = _eeprom.read(oldest, sizeof(oldest));
+    _eeprom.stop();
+    if (returnValue < 0) { return returnValue; }
+    __startStage__(next);
+    int16_t offset = PAGE_HEADER_SIZE;
+    int16_t length;
+    while ((length = __recordLength__(oldest, offset)) > 0) {
+        const uint8_t key = oldest[offset];
+        if (key < MAX_KEYS and _index[key] == __pageAddress__(next) + offset) { __addToStage__(&oldest[offset], length); }
+        offset += length;
+    }
+    return NO_ERROR;
+}
+#endif
@@ -74,7 +74,7 @@ namespace myADC {
      * @return true Channel is valid.
      * @return false Channel is invalid.
      */
-    bool inline validChannel(const uint8_t channel) {
+    constexpr bool validChannel(const uint8_t channel) {
         if (channel > (MY_ADC_NUM_CHANNELS - 1)) { return false; }
         return true;
     }
@@ -85,7 +85,7 @@ namespace myADC {
      * @return true Channel is a user channel.
      * @return false Channel is not a user channel.
      */
-    bool inline validUserChannel(const uint8_t channel) {
+    constexpr bool validUserChannel(const uint8_t channel) {
         if (channel > (MY_ADC_NUM_USER_CHANNELS - 1)) { return false; }
         return true;
     }
@@ -96,7 +96,7 @@ namespace myADC {
      * @return true 
      * @return false 
      */
-    bool inline validPin(const uint8_t pin) {
+    constexpr bool validPin(const uint8_t pin) {
         if (pin < MY_ADC_CHANNEL_0_PIN or pin > MY_ADC_CHANNEL_3_PIN) { return false; }
         return true;
     }
@@ -237,6 +237,22 @@ namespace myADC {
         _setPinInit(pin);
         return NO_ERROR;
     }
+    /**
+     * @brief Call adc_gpio_init for a pin validated at compile time.
+     * A pin that isn't an ADC pin fails to compile, so only the ADC and pin state are checked.
+     * IE: myADC::initPin<26>();
+     * @tparam PIN Pin to initialize.
+     * @return int16_t Returns 0 (NO_ERROR) for no error, negative for error code.
+     */
+    template <uint8_t PIN>
+    int16_t initPin() {
+        static_assert(validPin(PIN), "Not an ADC pin.");
+        if (getADCInit() == false) { return ERROR_ADC_NOT_INIT; }
+        if (getPinInit(PIN) == true) { return ERROR_CHANNEL_ALREADY_INIT; }
+        adc_gpio_init(PIN);
+        _setPinInit(PIN);
+        return NO_ERROR;
+    }
     /**
      * @brief Initialize the temperature sensor.
      * Calls adc_set_temp_sensor_enabled with true, and tracks if it's been called, this function is
@@ -119,8 +119,8 @@ class myAT24C32 {
          * @brief Write to the EEPROM
          * Preforms a write to the EEPROM. Returns 0 (NO_ERROR) if written okay, otherwise if an invalid
          * address or length are provided, an error code is returned. This blocks until the write is
-         * complete.
-         * @note The EEPROM writes in 32 byte pages only, the data is therefore split up into 32 byte chunks
+         * complete, found by ACK polling the EEPROM rather than waiting the worst case write time.
+         * @note The EEPROM writes in 32 byte pages only, the data is therefore split up at page boundaries
          * and written. The address counter does not roll over to the first address of the first page on write,
          * so the length of the write can only be to the end of the EEPROM.
          * @param address Address to start write at.
@@ -133,7 +133,7 @@ class myAT24C32 {
          * @brief Initialize the EEPROM.
          * Initializes the eeprom, and preforms a read to verify comms. Returns 0 (NO_ERROR) if 
          * initialized okay, otherwise it will return an error code.
-         * @param initI2C True = Initialize I2C bus (default). False = Don't initialize I2C bus, Assumes i2c bus already setup.
+         * @param initI2C True = Initialize I2C bus (default). False = Don't initialize I2C bus, Assumes i2c bus already setup. Skipped if another device already initialized the port.
          * @return int16_t Returns 0 (NO_ERROR) for init okay. Negative for error code.
          */
         int16_t initialize(const bool initI2C=true);
@@ -142,6 +142,7 @@ class myAT24C32 {
 /***************** Private constants: ***********************/
     // I2C:
         const uint16_t I2C_TIMEOUT = 50000; // 50 milliseconds.
+        const uint32_t WRITE_TIMEOUT_US = 20000; // Twice the 10 millisecond worst case write cycle.
     // Pins:
         const uint8_t _sdaPin = MY_NOT_A_PIN;
         const uint8_t _sclPin = MY_NOT_A_PIN;
@@ -152,6 +153,7 @@ class myAT24C32 {
         int16_t __read__(const uint16_t address, uint8_t *buffer, const size_t length);
         int16_t __writeByte__(const uint16_t address, uint8_t value);
         int16_t __write__(const uint16_t address, uint8_t *buffer, const size_t length);
+        int16_t __waitWriteCycle__(); // ACK poll until the write cycle is done, or timeout.
 };
 
 /****************** Public functions: ************************/
@@ -171,44 +173,18 @@ int16_t myAT24C32::read(const uint16_t address, uint8_t *buffer, const size_t le
 int16_t myAT24C32::write(const uint16_t address, uint8_t *buffer, const size_t length) {
     int16_t returnValue;
     size_t maxLen;
-    uint8_t numChunks;
-    uint8_t numRemaining;
-    int16_t writeAddress;
-    int16_t offset;
-    uint8_t dataBuffer[32];
+    size_t offset = 0;
     if (isValidAddress(address) == false) { return ERROR_INVALID_ADDRESS; }
     maxLen = (MAX_ADDRESS - address) + 1;
     if (length < 1 or length > maxLen) { return ERROR_INVALID_LENGTH; }
-    if (length <= PAGE_LENGTH) {
-        returnValue = __write__(address, buffer, length);
-        return returnValue;
-    }
- 
-    numChunks = length / PAGE_LENGTH;
-    numRemaining = length - (numChunks * PAGE_LENGTH);
-    for (uint8_t i=0; i<numChunks; i++) {
-        offset = i * 32;
-        writeAddress = address + offset;
-        for (uint16_t j=0; j<32; j++) {
-            uint16_t index = offset + j;
-            // printf("i=%i, offset=%i, j=%i index=%i\n", i, offset, j, index);
-            dataBuffer[j] = buffer[index];
-        }
-        returnValue = __write__(writeAddress, dataBuffer, 32);
+// Split at page boundaries, a write past the end of a page wraps to its start:
+    while (offset < length) {
+        const uint16_t writeAddress = address + offset;
+        const size_t chunk = MIN(length - offset, (size_t)(PAGE_LENGTH - (writeAddress % PAGE_LENGTH)));
+        returnValue = __write__(writeAddress, &buffer[offset], chunk);
         if (returnValue < 0) { return returnValue; }
-        sleep_ms(10);
-    }
-    if (numRemaining > 0) {
-        offset = numChunks * 32;
-        writeAddress = address + offset;
-        for (uint8_t i=0; i<numRemaining; i++) {
-            dataBuffer[i] = buffer[offset + i];
-        }
-        returnValue = __write__(writeAddress, dataBuffer, numRemaining);
-        return returnValue;
+        offset += chunk;
     }
-    // printf("Num chunks=%i\n", numChunks);
-    // printf("Num remaining=%i\n", numRemaining);
     return NO_ERROR;
 }
 
@@ -216,7 +192,7 @@ int16_t myAT24C32::initialize(const bool initI2C) {
     int32_t returnValue;
     uint8_t value;
 // Initialize i2c:
-    if (initI2C == true) {
+    if (initI2C == true and myI2C::getInitialized(_i2cPort) == false) {
         returnValue = myI2C::initializeMaster(_i2cPort, _sdaPin, _sclPin, 100*1000);
         if (returnValue < 0) { return (int16_t)returnValue; }
     }
@@ -236,12 +212,12 @@ int16_t myAT24C32::__read__(const uint16_t address, uint8_t *buffer, const size_
     // preform "dummy write" to set address.
     addressBuffer[0] = (uint8_t)(address >> 8);
     addressBuffer[1] = (uint8_t)address;
-    returnValue = i2c_write_timeout_us(_i2cPort, _address, addressBuffer, 2, true, I2C_TIMEOUT);
+    returnValue = myI2C::write_timeout_us(_i2cPort, _address, addressBuffer, 2, true, I2C_TIMEOUT);
     if (returnValue < 0) {
         if (returnValue == PICO_ERROR_GENERIC) { return ERROR_NOT_RESPONDING; }
         if (returnValue == PICO_ERROR_TIMEOUT) { return ERROR_TIMEOUT; }
     }
-    returnValue = i2c_read_timeout_us(_i2cPort, _address, buffer, length, false, I2C_TIMEOUT);
+    returnValue = myI2C::read_timeout_us(_i2cPort, _address, buffer, length, false, I2C_TIMEOUT);
     if (returnValue < 0) {
         if (returnValue == PICO_ERROR_GENERIC) { return ERROR_NOT_RESPONDING; }
         if (returnValue == PICO_ERROR_TIMEOUT) { return ERROR_TIMEOUT; }
@@ -259,13 +235,25 @@ int16_t myAT24C32::__write__(const uint16_t address, uint8_t *buffer, const size
     for (size_t i=0; i<length; i++) {
         dataBuffer[i+2] = buffer[i];
     }
-    sleep_ms(10);
-    returnValue = i2c_write_timeout_us(_i2cPort, _address, dataBuffer, length+2, false, I2C_TIMEOUT);
+    returnValue = myI2C::write_timeout_us(_i2cPort, _address, dataBuffer, length+2, false, I2C_TIMEOUT);
     if (returnValue < 0) {
         if (returnValue == PICO_ERROR_GENERIC) { return ERROR_NOT_RESPONDING; }
         if (returnValue == PICO_ERROR_TIMEOUT) { return ERROR_TIMEOUT; }
     }
-    sleep_ms(10); // Sleep to let the write complete.
-    return NO_ERROR;
+    return __waitWriteCycle__();
+}
+
+int16_t myAT24C32::__waitWriteCycle__() {
+    int32_t returnValue;
+    uint8_t value;
+// The EEPROM doesn't acknowledge its address until the write cycle is done. A zero length write
+// can't be sent, so poll with a one byte read, which only moves the address counter:
+    const uint32_t startTime = time_us_32();
+    while (true) {
+        returnValue = myI2C::read_timeout_us(_i2cPort, _address, &value, 1, false, I2C_TIMEOUT);
+        if (returnValue >= 0) { return NO_ERROR; }
+        if (returnValue == PICO_ERROR_TIMEOUT) { return ERROR_TIMEOUT; }
+        if ((time_us_32() - startTime) >= WRITE_TIMEOUT_US) { return ERROR_TIMEOUT; }
+    }
 }
 #endif
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "../../myStandardDefines.hpp"
 #include "../../myErrorCodes.hpp"
 #include "../../myHelpers.hpp"
+#include "../../myI2C/myI2C.hpp"
 
 class myBMx280 {
     public:
@@ -473,7 +474,7 @@ class myBMx280 {
 		 * @param config The config byte to write to the chip, defaults to standby time of 500us, filter off, comms in 4 wire mode.
 		 * @param measCtrl The measCtrl byte to write to the chip, defaults to temperature =OSR_X1, pressure=OSR_X1, mode = MODE_FORCED.
 		 * @param humCtrl The humCtrl byte to write to the chip if available, defaults to humidty = OSR_X1
-		 * @param initI2C Initialize the i2c bus.
+		 * @param initI2C Initialize the i2c bus, skipped if the port is already initialized.
 		 * @return int32_t Positive is the achieved baud rate, negaitive for error code.
 		 */
 		int32_t	initialize(const uint8_t config=DEFAULT_CONFIG, const uint8_t measCtrl=DEFAULT_MEAS_SETTINGS,
@@ -804,7 +805,7 @@ myBMx280::myBMx280(i2c_inst_t *i2cPort, const uint8_t sdaPin, const uint8_t sclP
         uint8_t chipID;
     // Init I2C:
         if (verifyAddress(_address) == false) { return ERROR_INVALID_ADDRESS; }
-		if (initI2C == true) {
+		if (initI2C == true and myI2C::getInitialized(_i2cPort) == false) {
 			baudRate = myI2C::initializeMaster(_i2cPort, _sdaPin, _sclPin, 3200*1000);
 			// printf("Got baud: %i\n", baudRate);
 			if (baudRate < 0) { return baudRate; } // Error occured, return the error.
@@ -895,12 +896,12 @@ myBMx280::myBMx280(i2c_inst_t *i2cPort, const uint8_t sdaPin, const uint8_t sclP
  */
 int16_t myBMx280::__readRegisters__(const uint8_t reg, uint8_t *buffer, const uint8_t length) {
     int32_t returnValue;
-    returnValue = i2c_write_timeout_us(_i2cPort, _address, &reg, 1, true, TIMEOUT_US);
+    returnValue = myI2C::write_timeout_us(_i2cPort, _address, &reg, 1, true, TIMEOUT_US);
     if (returnValue < 0) {
         if (returnValue == PICO_ERROR_GENERIC) { return ERROR_NO_RESPONSE; }
         if (returnValue == PICO_ERROR_TIMEOUT) { return ERROR_TIMEOUT; }
     } 
-    returnValue = i2c_read_timeout_us(_i2cPort, _address, buffer, length, false, TIMEOUT_US);
+    returnValue = myI2C::read_timeout_us(_i2cPort, _address, buffer, length, false, TIMEOUT_US);
     if (returnValue < 0) {
         if (returnValue == PICO_ERROR_GENERIC) { return ERROR_NO_RESPONSE; }
         if (returnValue == PICO_ERROR_TIMEOUT) { return ERROR_TIMEOUT; }
@@ -911,7 +912,7 @@ int16_t myBMx280::__readRegisters__(const uint8_t reg, uint8_t *buffer, const ui
 int16_t myBMx280::__writeRegister__(const uint8_t reg, const uint8_t value) {
     int32_t returnValue;
     const uint8_t buffer[2] = {reg, value};
-    returnValue = i2c_write_timeout_us(_i2cPort, _address, buffer, 2, false, TIMEOUT_US);
+    returnValue = myI2C::write_timeout_us(_i2cPort, _address, buffer, 2, false, TIMEOUT_US);
     if (returnValue < 0) {
         if (returnValue == PICO_ERROR_GENERIC) { return ERROR_NO_RESPONSE; }
         if (returnValue == PICO_ERROR_TIMEOUT) { return ERROR_TIMEOUT; }
@@ -378,7 +378,7 @@ class myBMx280 {
 		 * @param config The config byte to write to the chip, defaults to standby time of 500us, filter off, comms in 4 wire mode.
 		 * @param measCtrl The measCtrl byte to write to the chip, defaults to temperature =OSR_X1, pressure=OSR_X1, mode = MODE_FORCED.
 		 * @param humCtrl The humCtrl byte to write to the chip if available, defaults to humidty = OSR_X1
-		 * @param initSPI If true, the default it will try and initialize the spi bus, otherwise it will assum it's already setup.
+		 * @param initSPI If true, the default it will try and initialize the spi bus, otherwise it will assum it's already setup. Skipped if the port is already initialized.
 		 * @return true if initialized okay.
 		 * @return false if not initialized okay.
 		 */
@@ -439,6 +439,7 @@ class myBMx280 {
 	/* Private Variables: */
 		// SPI Variables:
 		spi_inst_t *_spiObj;
+		int16_t _profileId = -1;	// mySPI profile.
 		uint8_t _csPin;
 		uint8_t _sckPin;
 		uint8_t _misoPin;
@@ -639,9 +640,18 @@ bool myBMx280::setMode(const uint8_t value) {
 bool myBMx280::initialize(const uint8_t config, const uint8_t measCtrl, const uint8_t humCtrl,
 								const bool initSPI) {
 // Init SPI:
-	if (initSPI == true) {
+	if (initSPI == true and mySPI::getPortInit(_spiObj) == false) {
 		mySPI::initializeMaster(_spiObj, _sckPin, _misoPin, _mosiPin, 1000*20000);
 	}
+// Register a profile once, so other devices on the port get their own format and speed back:
+	if (_profileId < 0) {
+		mySPI::profile_t profile;
+		profile.baudRate = 1000*20000;
+		profile.csPin = _csPin;
+		int16_t returnValue = mySPI::registerProfile(_spiObj, profile);
+		if (returnValue < 0) { return false; }
+		_profileId = returnValue;
+	}
 // Setup CS Pin as OUTPUT HIGH.
     gpio_set_function(_csPin, GPIO_FUNC_SIO);  // CS pin is GPIO
     gpio_set_dir(_csPin, GPIO_OUT);
@@ -712,6 +722,7 @@ void myBMx280::update() {
 }
 
 void inline myBMx280::__selectChip__() {
+	mySPI::selectProfile(_spiObj, _profileId);
 	gpio_put(_csPin, false);
 }
 
@@ -722,15 +733,15 @@ void inline myBMx280::__deselectChip__() {
 void myBMx280::__readRegisters__(const uint8_t reg, uint8_t *buffer, const uint8_t length) {
 	uint8_t address = reg | READ_BIT;
 	__selectChip__();
-	spi_write_blocking(_spiObj, &address, 1);
-	spi_read_blocking(_spiObj, 0, buffer, length);
+	mySPI::write_blocking(_spiObj, &address, 1);
+	mySPI::read_blocking(_spiObj, 0, buffer, length);
 	__deselectChip__();
 }
 
 void myBMx280::__writeRegister__(const uint8_t reg, const uint8_t value) {
 	__selectChip__();
 	uint8_t buffer[2] = { reg, value };
-	spi_write_blocking(_spiObj, buffer, 2);
+	mySPI::write_blocking(_spiObj, buffer, 2);
 	__deselectChip__();
 }
 
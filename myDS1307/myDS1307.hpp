@@ -1130,7 +1130,7 @@ int16_t myDS1307::initialize(const bool initI2C, const bool trackCenturies) {
     int32_t returnValue;
     // Initialize i2c at 50 KHz, since we're running at 3.3v which is underspec, we give it more
     // time to respond. Otherwise occasionally the chip will not respond, and we throw an error.
-    if (initI2C == true) {
+    if (initI2C == true and myI2C::getInitialized(_i2cPort) == false) {
         returnValue = myI2C::initializeMaster(_i2cPort, _sdaPin, _sclPin, 50*1000);
         if (returnValue < 0) { return (int16_t)returnValue; }
     }
@@ -1148,12 +1148,12 @@ int16_t myDS1307::initialize(const bool initI2C, const bool trackCenturies) {
 
 int16_t myDS1307::__readRegisters__(const uint8_t reg, uint8_t *buffer, size_t length) {
     int16_t returnValue;
-    returnValue = i2c_write_timeout_us(_i2cPort, I2C_ADDRESS, &reg, 1, true, I2C_TIMEOUT_US);
+    returnValue = myI2C::write_timeout_us(_i2cPort, I2C_ADDRESS, &reg, 1, true, I2C_TIMEOUT_US);
     if (returnValue < 0) {
         if (returnValue == PICO_ERROR_GENERIC) { return ERROR_NOT_RESPONDING; }
         if (returnValue == PICO_ERROR_TIMEOUT) { return ERROR_TIMEOUT; }
     }
-    returnValue = i2c_read_timeout_us(_i2cPort, I2C_ADDRESS, buffer, length, false, I2C_TIMEOUT_US);
+    returnValue = myI2C::read_timeout_us(_i2cPort, I2C_ADDRESS, buffer, length, false, I2C_TIMEOUT_US);
     if (returnValue < 0) {
         if (returnValue == PICO_ERROR_GENERIC) { return ERROR_NOT_RESPONDING; }
         if (returnValue == PICO_ERROR_TIMEOUT) { return ERROR_TIMEOUT; }
@@ -1170,7 +1170,7 @@ int16_t myDS1307::__writeRegisters__(const uint8_t reg, uint8_t *buffer, size_t
         dataBuffer[i+1] = buffer[i];
     }
 // Send buffer:
-    returnValue = i2c_write_timeout_us(_i2cPort, I2C_ADDRESS, dataBuffer, length+1, false, I2C_TIMEOUT_US);
+    returnValue = myI2C::write_timeout_us(_i2cPort, I2C_ADDRESS, dataBuffer, length+1, false, I2C_TIMEOUT_US);
     if (returnValue < 0) {
         if (returnValue == PICO_ERROR_GENERIC) { return ERROR_NOT_RESPONDING; }
         if (returnValue == PICO_ERROR_TIMEOUT) { return ERROR_TIMEOUT; }
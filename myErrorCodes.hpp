@@ -236,6 +236,41 @@
      * The spi port is already deinialized.
      */
     #define MY_ERROR_SPI_NOT_INITIALIZED                          -155
+    /**
+     * @brief Transaction queue full.
+     * The spi transaction queue was full when a transaction was submitted.
+     */
+    #define MY_ERROR_SPI_QUEUE_FULL                               -156
+    /**
+     * @brief Profile table full.
+     * No free slot was available when a profile was registered.
+     */
+    #define MY_ERROR_SPI_PROFILES_FULL                            -157
+    /**
+     * @brief Invalid profile.
+     * The profile id is not registered, or belongs to another spi port.
+     */
+    #define MY_ERROR_SPI_INVALID_PROFILE                          -158
+    /**
+     * @brief No frame available.
+     * No completed slave frame was waiting to be read.
+     */
+    #define MY_ERROR_SPI_NO_FRAME                                 -159
+    /**
+     * @brief Receive overrun.
+     * Slave frame data was overwritten before it was released.
+     */
+    #define MY_ERROR_SPI_OVERRUN                                  -160
+    /**
+     * @brief Port busy.
+     * The spi port was owned by the other core until the acquire timed out.
+     */
+    #define MY_ERROR_SPI_PORT_BUSY                                -161
+    /**
+     * @brief Not port owner.
+     * The spi port was released by a core that doesn't own it.
+     */
+    #define MY_ERROR_SPI_NOT_OWNER                                -162
 /*************** RESERVERED (175-199) ****************************/
 /************* myADC error codes (200-224)  **************/
 // *NOTE: Error codes are such a that the pico would stop operating
@@ -334,6 +369,36 @@
      * Communications couldn't be verified.
      */
     #define MY_ERROR_MY23LC1024_COMM_CHECK_FAILED           -310
+    /**
+     * @brief Invalid length.
+     * The length was zero, or longer than the sram.
+     */
+    #define MY_ERROR_MY23LC1024_INVALID_LENGTH              -311
+    /**
+     * @brief Invalid handle.
+     * The heap handle is out of range or not allocated.
+     */
+    #define MY_ERROR_MY23LC1024_INVALID_HANDLE              -312
+    /**
+     * @brief Out of memory.
+     * The heap has no free space large enough, even after compacting.
+     */
+    #define MY_ERROR_MY23LC1024_OUT_OF_MEMORY               -313
+    /**
+     * @brief No free handles.
+     * All heap handles are in use.
+     */
+    #define MY_ERROR_MY23LC1024_NO_HANDLES                  -314
+    /**
+     * @brief Handle pinned.
+     * The heap handle is pinned when operation was requested.
+     */
+    #define MY_ERROR_MY23LC1024_HANDLE_PINNED               -315
+    /**
+     * @brief Handle not pinned.
+     * The heap handle was not pinned when operation was requested.
+     */
+    #define MY_ERROR_MY23LC1024_HANDLE_NOT_PINNED           -316
 /*************** my25xx640A Error codes (325-349)*******************/
     /**
      * @brief Invalid address.
@@ -390,6 +455,36 @@
      * The write protect is already disabled.
      */
     #define MY_ERROR_MY25xx640A_NOT_WRITE_PROTECTED         -335
+    /**
+     * @brief Log not mounted.
+     * The record log was used before mount() or format().
+     */
+    #define MY_ERROR_MY25xx640A_LOG_NOT_MOUNTED             -336
+    /**
+     * @brief Invalid log key.
+     * The record key is past the last key the log indexes.
+     */
+    #define MY_ERROR_MY25xx640A_LOG_INVALID_KEY             -337
+    /**
+     * @brief Invalid record length.
+     * The record is too long to fit in a page.
+     */
+    #define MY_ERROR_MY25xx640A_LOG_INVALID_LENGTH          -338
+    /**
+     * @brief Key not found.
+     * No record has been logged for the key.
+     */
+    #define MY_ERROR_MY25xx640A_LOG_KEY_NOT_FOUND           -339
+    /**
+     * @brief Record CRC mismatch.
+     * The record read back doesn't match its CRC.
+     */
+    #define MY_ERROR_MY25xx640A_LOG_CRC                     -340
+    /**
+     * @brief Log full.
+     * Garbage collection couldn't free room, every page holds live records.
+     */
+    #define MY_ERROR_MY25xx640A_LOG_FULL                    -341
 /*************** mySNx4HC165 error codes (350-399) *****************/
     /**
      * @brief Enable pin not defined.
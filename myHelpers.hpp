@@ -24,12 +24,12 @@
 namespace myHelpers {
     /**
      * @brief Validate if the pin is a valid pin number for the rp2040.
-     * 
+     * Usable in constant expressions, to check pins at compile time.
      * @param pin Pin to validate.
      * @return true is a valid pin
      * @return false is not a valid pin
      */
-    bool inline isPin(const uint8_t pin) {
+    constexpr bool isPin(const uint8_t pin) {
     #ifdef RASPBERRYPI_PICO
         if (pin == 23) { return false; }
         if (pin == 24) { return false; }
@@ -457,6 +457,35 @@ namespace myHelpers {
     }
 
 /****************************** Reverse functions: ***********************************/
+    /** @private */
+    static const uint8_t _reverse8Table[256] = {
+        0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
+        0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8, 0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
+        0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4, 0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
+        0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
+        0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2, 0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
+        0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA, 0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
+        0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6, 0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
+        0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE, 0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
+        0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1, 0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
+        0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9, 0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
+        0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5, 0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
+        0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED, 0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
+        0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3, 0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
+        0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB, 0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
+        0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7, 0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
+        0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF, 0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFF
+    };
+    /** @private */
+    typedef uint32_t __attribute__((__may_alias__)) _word_t; // Word view of byte buffers.
+    /** @private */
+    uint32_t inline __reverseBytesInWord__(uint32_t value) {
+        // Swap bits, then pairs, then nibbles. Reverses the bits of all 4 bytes at once.
+        value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+        value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+        value = ((value >> 4) & 0x0F0F0F0F) | ((value & 0x0F0F0F0F) << 4);
+        return value;
+    }
     /**
      * @brief Reverse an 8 bit word.
      * Sets the msb = to lsb. and so on until the word is reversed. used to convert
@@ -464,15 +493,8 @@ namespace myHelpers {
      * @param value Word to reverse.
      * @return uint8_t Reversed word.
      */
-    uint8_t reverse8(const uint8_t value) {
-        uint8_t returnValue = 0x00;
-        for (uint8_t i=0; i<8; i++) {
-            returnValue <<= 1;
-            if ((bool)(value & (1<<i)) == true) {
-                returnValue |= 0x01;
-            }
-        }
-        return returnValue;
+    uint8_t inline reverse8(const uint8_t value) {
+        return _reverse8Table[value];
     }
     /**
      * @brief Reverse a 16 bit word.
@@ -481,15 +503,151 @@ namespace myHelpers {
      * @param value Word to reverse.
      * @return uint16_t Reversed word.
      */
-    uint16_t reverse16(const uint16_t value) {
-        uint16_t returnValue = 0x0000;
-        for (uint8_t i=0; i<16; i++) {
-            returnValue <<= 1;
-            if ((bool)(value& (1 << i)) == true) {
-                returnValue |= 0x01;
+    uint16_t inline reverse16(const uint16_t value) {
+        return (uint16_t)((_reverse8Table[value & 0xFF] << 8) | _reverse8Table[value >> 8]);
+    }
+    /**
+     * @brief Reverse a 32 bit word.
+     * Sets MSB = to LSB, and so on until the word is reversed.
+     * @param value Word to reverse.
+     * @return uint32_t Reversed word.
+     */
+    uint32_t inline reverse32(const uint32_t value) {
+        return __builtin_bswap32(__reverseBytesInWord__(value));
+    }
+    /**
+     * @brief Reverse the bits of each byte in a buffer.
+     * Copies src to dst reversing the bits of each byte. Word aligned runs are reversed 4 bytes
+     * at a time, the rest by table lookup. src and dst may be the same buffer.
+     * @param dst Buffer to store reversed bytes.
+     * @param src Buffer to reverse.
+     * @param len Length of buffers in bytes.
+     */
+    void reverse8Buffer(uint8_t *dst, const uint8_t *src, size_t len) {
+        size_t i = 0;
+    // Table until src is aligned:
+        while (i < len and ((uintptr_t)&src[i] & 0x03) != 0) {
+            dst[i] = _reverse8Table[src[i]];
+            i++;
+        }
+    // Word at a time if dst is aligned as well:
+        if (((uintptr_t)&dst[i] & 0x03) == 0) {
+            const _word_t *srcWords = (const _word_t *)&src[i];
+            _word_t *dstWords = (_word_t *)&dst[i];
+            const size_t numWords = (len - i) / 4;
+            for (size_t j=0; j<numWords; j++) {
+                dstWords[j] = __reverseBytesInWord__(srcWords[j]);
+            }
+            i += numWords * 4;
+        }
+    // Table for the rest:
+        while (i < len) {
+            dst[i] = _reverse8Table[src[i]];
+            i++;
+        }
+    }
+    /**
+     * @brief Reverse the bits of each byte in a buffer in place.
+     * @param buffer Buffer to reverse.
+     * @param len Length of buffer in bytes.
+     */
+    void inline reverse8Buffer(uint8_t *buffer, size_t len) {
+        reverse8Buffer(buffer, buffer, len);
+    }
+    /**
+     * @brief Reverse the bits of each half word in a buffer.
+     * Copies src to dst reversing the bits of each half word. Pairs of half words are reversed
+     * a word at a time when aligned. src and dst may be the same buffer.
+     * @param dst Buffer to store reversed half words.
+     * @param src Buffer to reverse.
+     * @param len Length of buffers in half words.
+     */
+    void reverse16Buffer(uint16_t *dst, const uint16_t *src, size_t len) {
+        size_t i = 0;
+        if (((uintptr_t)src & 0x03) != 0 and len > 0) {
+            dst[0] = reverse16(src[0]);
+            i = 1;
+        }
+        if (((uintptr_t)&dst[i] & 0x03) == 0) {
+            const _word_t *srcWords = (const _word_t *)&src[i];
+            _word_t *dstWords = (_word_t *)&dst[i];
+            const size_t numWords = (len - i) / 2;
+            for (size_t j=0; j<numWords; j++) {
+                // Reverse the bytes, then swap them within each half word.
+                const uint32_t value = __reverseBytesInWord__(srcWords[j]);
+                dstWords[j] = ((value >> 8) & 0x00FF00FF) | ((value & 0x00FF00FF) << 8);
+            }
+            i += numWords * 2;
+        }
+        while (i < len) {
+            dst[i] = reverse16(src[i]);
+            i++;
+        }
+    }
+    /**
+     * @brief Reverse the bits of each half word in a buffer in place.
+     * @param buffer Buffer to reverse.
+     * @param len Length of buffer in half words.
+     */
+    void inline reverse16Buffer(uint16_t *buffer, size_t len) {
+        reverse16Buffer(buffer, buffer, len);
+    }
+    /**
+     * @brief Reverse the bits of each word in a buffer.
+     * Copies src to dst reversing the bits of each word. src and dst may be the same buffer.
+     * @param dst Buffer to store reversed words.
+     * @param src Buffer to reverse.
+     * @param len Length of buffers in words.
+     */
+    void reverse32Buffer(uint32_t *dst, const uint32_t *src, size_t len) {
+        for (size_t i=0; i<len; i++) {
+            dst[i] = reverse32(src[i]);
+        }
+    }
+    /**
+     * @brief Reverse the bits of each word in a buffer in place.
+     * @param buffer Buffer to reverse.
+     * @param len Length of buffer in words.
+     */
+    void inline reverse32Buffer(uint32_t *buffer, size_t len) {
+        reverse32Buffer(buffer, buffer, len);
+    }
+/************************ CRC functions: ************************/
+    /**
+     * @brief CRC-32 of a buffer, MSB first.
+     * IEEE 802.3 polynomial with no reflection and no final xor, the same as the RP2040 DMA
+     * sniffer's CRC32 mode. Pass the last result as crc to continue over more data.
+     * @param data Data to check.
+     * @param len Length of data in bytes.
+     * @param crc Starting value, defaults to 0xFFFFFFFF.
+     * @return uint32_t The CRC.
+     */
+    uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc=0xFFFFFFFF) {
+        for (size_t i=0; i<len; i++) {
+            crc ^= (uint32_t)data[i] << 24;
+            for (uint8_t bit=0; bit<8; bit++) {
+                crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : crc << 1;
+            }
+        }
+        return crc;
+    }
+    /**
+     * @brief CRC-16 of a buffer, MSB first.
+     * CCITT polynomial 0x1021 with no reflection and no final xor, the same as the RP2040 DMA
+     * sniffer's CRC16 mode. Pass the last result as crc to continue over more data.
+     * @param data Data to check.
+     * @param len Length of data in bytes.
+     * @param crc Starting value, defaults to 0xFFFF.
+     * @return uint16_t The CRC.
+     */
+    uint16_t crc16(const uint8_t *data, size_t len, uint16_t crc=0xFFFF) {
+        for (size_t i=0; i<len; i++) {
+            crc ^= (uint16_t)data[i] << 8;
+            for (uint8_t bit=0; bit<8; bit++) {
+                crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
             }
         }
-        return returnValue;
+        return crc;
     }
 /******************** Date time functions: **********************/
 
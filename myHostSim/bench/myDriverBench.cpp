@@ -0,0 +1,459 @@
+/**
+ * @file myDriverBench.cpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Host benchmark of the 23LC1024, 25xx640A and AT24C32 drivers against their models.
+ * @version 0.1
+ * @date 2022-08-10
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Runs each driver fast path against the myHostSim models, and prints its virtual time and bus
+ * counters next to the slower path it replaced, where that path is still in the tree. Every case
+ * checks its data, and the counts the virtual clock makes exact. The cache, FIFO, heap and log
+ * containers are checked too, with the failures their fixes cover. Exits with 1 if any check fails.
+ */
+#include "../models/my23LC1024Model.hpp"
+#include "../models/my25xx640AModel.hpp"
+#include "../models/myAT24C32Model.hpp"
+#include "../../my23LC1024/my23LC1024.hpp"
+#include "../../my23LC1024/my23LC1024Array.hpp"
+#include "../../my23LC1024/my23LC1024ExtArray.hpp"
+#include "../../my23LC1024/my23LC1024Cache.hpp"
+#include "../../my23LC1024/my23LC1024FIFO.hpp"
+#include "../../my23LC1024/my23LC1024Heap.hpp"
+#include "../../my25xx640A/my25xx640A.hpp"
+#include "../../my25xx640A/my25xx640ALog.hpp"
+#include "../../myAT24C32/myAT24C32.hpp"
+
+/* ##################### Devices: ##################### */
+// SPI0: sram0 on 17, sram2 on 20, eeprom on 21. SPI1: sram1 on 13. I2C0: AT24C32 at 0x50.
+static my23LC1024Model sramModel0, sramModel1, sramModel2;
+static my25xx640AModel eepromModel;
+static myAT24C32Model atModel;
+static my23LC1024 sram0(spi0, 17, 18, 16, 19);
+static my23LC1024 sram1(spi1, 13, 10, 12, 11);
+static my23LC1024 sram2(spi0, 20, 18, 16, 19);
+static my25xx640A eeprom(spi0, 18, 16, 19, 21);
+static myAT24C32 at24(i2c0, 4, 5, 0x50);
+
+static uint8_t _bufferA[2 * my23LC1024::LENGTH];          // Room for the two chip array.
+static uint8_t _bufferB[2 * my23LC1024::LENGTH];
+static int _failures = 0;
+
+/* ##################### Helpers: ##################### */
+static void check(const char *name, const bool passed) {
+    if (passed == false) {
+        printf("  FAIL: %s\n", name);
+        _failures++;
+    }
+}
+
+static double elapsedMs(const uint64_t startNs) {
+    return (double)(myHostSim::getTimeNs() - startNs) / 1e6;
+}
+
+static uint32_t spiTransactions(spi_inst_t *spiPort) {
+    return myHostSim::getSpiCounters(spiPort).transactions;
+}
+
+static void fillPattern(uint8_t *buffer, const int32_t length, const uint8_t seed) {
+    for (int32_t i=0; i<length; i++) { buffer[i] = (uint8_t)(i * 7 + (i >> 8) + seed); }
+}
+
+/* ##################### Cases: ##################### */
+// 23LC1024 readBuffer / writeBuffer, one chip select cycle each:
+static void benchBulk() {
+    printf("23LC1024 bulk, 128KB write and read back:\n");
+    fillPattern(_bufferA, my23LC1024::LENGTH, 1);
+    myHostSim::resetCounters();
+    uint64_t startNs = myHostSim::getTimeNs();
+    check("writeBuffer", sram0.writeBuffer(0, _bufferA, my23LC1024::LENGTH) == my23LC1024::LENGTH);
+    check("readBuffer", sram0.readBuffer(0, _bufferB, my23LC1024::LENGTH) == my23LC1024::LENGTH);
+    const uint32_t transactions = spiTransactions(spi0);
+    printf("  bulk:      %8.2f ms, %u cs cycles\n", elapsedMs(startNs), transactions);
+    check("data", memcmp(_bufferA, _bufferB, my23LC1024::LENGTH) == 0);
+    check("2 cs cycles", transactions == 2);
+    startNs = myHostSim::getTimeNs();
+    sram0.startWrite(0);
+    for (int32_t i=0; i<my23LC1024::LENGTH; i++) { sram0.write(_bufferA[i]); }
+    sram0.stop();
+    printf("  byte loop: %8.2f ms (write only)\n", elapsedMs(startNs));
+}
+
+// my23LC1024Array, two chips on their own ports against two on one port:
+static double __stripedRun__(my23LC1024 &first, my23LC1024 &second) {
+    const int32_t length = 200000;
+    my23LC1024 *chips[2] = { &first, &second };
+    my23LC1024Array array(chips, 2);
+    fillPattern(_bufferA, length, 2);
+    const uint64_t startNs = myHostSim::getTimeNs();
+    check("array write", array.write(100, _bufferA, length) == length);
+    check("array read", array.read(100, _bufferB, length) == length);
+    const double ms = elapsedMs(startNs);
+    check("array data", memcmp(_bufferA, _bufferB, length) == 0);
+    return ms;
+}
+
+static void benchArray() {
+    printf("23LC1024 array, 200KB write and read back over two chips:\n");
+    const double twoPorts = __stripedRun__(sram0, sram1);
+    const double onePort = __stripedRun__(sram0, sram2);
+    printf("  two ports: %8.2f ms\n  one port:  %8.2f ms\n", twoPorts, onePort);
+    check("two ports in about half the time", twoPorts < onePort * 0.55);
+}
+
+// transferBatch, adjacent operations sharing chip select windows:
+static void benchBatch() {
+    printf("23LC1024 transferBatch, 7 scattered operations:\n");
+    for (int32_t i=0; i<my23LC1024::LENGTH; i++) { _bufferA[i] = (uint8_t)(i * 3); }
+    sram0.writeBuffer(0, _bufferA, my23LC1024::LENGTH);
+    uint8_t w1[10], w2[20], w3[5], r1[16], r2[4], r3[30], r4[8];
+    memset(w1, 0xA1, sizeof(w1));
+    memset(w2, 0xB2, sizeof(w2));
+    memset(w3, 0xC3, sizeof(w3));
+    my23LC1024::batchOp_t ops[] = {
+        {5000, r1, 16, false}, {110, w2, 20, true}, {5020, r2, 4, false}, {100, w1, 10, true},
+        {90000, w3, 5, true}, {95, r3, 30, false}, {131064, r4, 8, false},
+    };
+    myHostSim::resetCounters();
+    uint64_t startNs = myHostSim::getTimeNs();
+    check("transferBatch", sram0.transferBatch(ops, 7) == 93);
+    const uint32_t windows = spiTransactions(spi0);
+    printf("  batch:     %8.3f ms, %u cs windows\n", elapsedMs(startNs), windows);
+    check("5 cs windows", windows == 5);
+    bool ok = true;
+    for (int i=0; i<16; i++) { ok &= (r1[i] == (uint8_t)((5000 + i) * 3)); }
+    for (int i=0; i<4; i++) { ok &= (r2[i] == (uint8_t)((5020 + i) * 3)); }
+    for (int i=0; i<30; i++) {
+        const int address = 95 + i;
+        const uint8_t expected = (address < 100 or address >= 130) ? (uint8_t)(address * 3) : (address < 110) ? 0xA1 : 0xB2;
+        ok &= (r3[i] == expected);
+    }
+    for (int i=0; i<8; i++) { ok &= (r4[i] == (uint8_t)((131064 + i) * 3)); }
+    check("batch data", ok == true and sramModel0.memory[90004] == 0xC3);
+    myHostSim::resetCounters();
+    startNs = myHostSim::getTimeNs();
+    for (uint8_t i=0; i<7; i++) {
+        if (ops[i].write == true) {
+            sram0.writeBuffer(ops[i].address, ops[i].buffer, ops[i].length);
+        } else {
+            sram0.readBuffer(ops[i].address, ops[i].buffer, ops[i].length);
+        }
+    }
+    printf("  one by one:%8.3f ms, %u cs windows\n", elapsedMs(startNs), spiTransactions(spi0));
+}
+
+// my23LC1024ExtArray iterator windows against per element get():
+static void benchExtArray() {
+    struct sample_t { uint32_t time; int16_t value; uint8_t flags; };
+    printf("23LC1024 ExtArray, 5000 eight byte elements:\n");
+    my23LC1024ExtArray<sample_t> array(sram0, 1000, 5000);
+    static sample_t samples[5000];
+    for (int i=0; i<5000; i++) { samples[i] = { (uint32_t)i * 10, (int16_t)(i - 2500), (uint8_t)i }; }
+    check("copyIn", array.copyIn(0, samples, 5000) == 5000);
+    int64_t expected = 0;
+    for (int i=0; i<5000; i++) { expected += samples[i].value + samples[i].time; }
+    myHostSim::resetCounters();
+    uint64_t startNs = myHostSim::getTimeNs();
+    int64_t sum = 0;
+    for (const sample_t &sample : array) { sum += sample.value + sample.time; }
+    const uint32_t transactions = spiTransactions(spi0);
+    printf("  iterator:  %8.2f ms, %u transactions\n", elapsedMs(startNs), transactions);
+    check("iterator data", sum == expected);
+    check("157 transactions", transactions == 157);
+    myHostSim::resetCounters();
+    startNs = myHostSim::getTimeNs();
+    sum = 0;
+    for (int32_t i=0; i<array.size(); i++) {
+        sample_t sample;
+        array.get(i, sample);
+        sum += sample.value + sample.time;
+    }
+    printf("  get():     %8.2f ms, %u transactions\n", elapsedMs(startNs), spiTransactions(spi0));
+    check("get data", sum == expected);
+}
+
+// scan, DMA of the next chunk overlapping the callback:
+struct __scanState__ {
+    uint32_t sum;
+};
+
+static bool __scanChunk__(const int32_t address, const uint8_t *buffer, const int32_t length, void *userData) {
+    __scanState__ *state = (__scanState__ *)userData;
+    for (int32_t i=0; i<length; i++) { state->sum += buffer[i] * (uint32_t)(i + 1); }
+    myHostSim::advanceUs(100);             // Work on the chunk.
+    return true;
+}
+
+static void benchScan() {
+    printf("23LC1024 scan, 128KB with 100us of work per 1KB chunk:\n");
+    fillPattern(_bufferA, my23LC1024::LENGTH, 3);
+    sram0.writeBuffer(0, _bufferA, my23LC1024::LENGTH);
+    static uint8_t chunks[2048];
+    __scanState__ scanned = { 0 };
+    uint64_t startNs = myHostSim::getTimeNs();
+    check("scan", sram0.scan(0, my23LC1024::LENGTH, chunks, 1024, __scanChunk__, &scanned) == my23LC1024::LENGTH);
+    const double scanMs = elapsedMs(startNs);
+    __scanState__ serial = { 0 };
+    startNs = myHostSim::getTimeNs();
+    for (int32_t address=0; address<my23LC1024::LENGTH; address+=1024) {
+        sram0.readBuffer(address, chunks, 1024);
+        __scanChunk__(address, chunks, 1024, &serial);
+    }
+    const double serialMs = elapsedMs(startNs);
+    printf("  scan:            %8.2f ms\n  read then work:  %8.2f ms\n", scanMs, serialMs);
+    check("scan data", scanned.sum == serial.sum);
+    check("scan overlaps", scanMs < serialMs);
+}
+
+// 23LC1024 CRC by the DMA sniffer and in software, against myHelpers:
+static bool __scanStop__(const int32_t address, const uint8_t *buffer, const int32_t length, void *userData) {
+    int32_t *chunksLeft = (int32_t *)userData;
+    (*chunksLeft)--;
+    return (*chunksLeft > 0);
+}
+
+static uint32_t __crcOf__(const uint8_t mode, const uint8_t *buffer, const int32_t length) {
+    if (mode == my23LC1024::CRC_MODE_CRC32) { return myHelpers::crc32(buffer, length); }
+    return myHelpers::crc16(buffer, length);
+}
+
+static void benchCrc() {
+    printf("23LC1024 CRC, sniffer and software:\n");
+    static uint8_t chunks[2048];
+    const uint8_t modes[2] = { my23LC1024::CRC_MODE_CRC32, my23LC1024::CRC_MODE_CRC16 };
+    fillPattern(_bufferA, 4096, 5);
+    for (uint8_t i=0; i<2; i++) {
+        const uint8_t mode = modes[i];
+        sram0.setCrcMode(mode);
+        sram0.writeBuffer(0, _bufferA, 4096);
+        check("crc writeBuffer dma", sram0.getCrc() == __crcOf__(mode, _bufferA, 4096));
+        sram0.readBuffer(0, _bufferB, 4096);
+        check("crc readBuffer dma", sram0.getCrc() == __crcOf__(mode, _bufferA, 4096));
+        sram0.readBuffer(0, _bufferB, 5);
+        check("crc readBuffer software", sram0.getCrc() == __crcOf__(mode, _bufferA, 5));
+    // Stopped after 3 chunks, with the 4th in flight:
+        int32_t chunksLeft = 3;
+        check("crc scan dma stops", sram0.scan(0, 4096, chunks, 1024, __scanStop__, &chunksLeft) == 3072);
+        check("crc scan dma", sram0.getCrc() == __crcOf__(mode, _bufferA, 3072));
+        chunksLeft = 3;
+        check("crc scan software stops", sram0.scan(0, 4096, chunks, 4, __scanStop__, &chunksLeft) == 12);
+        check("crc scan software", sram0.getCrc() == __crcOf__(mode, _bufferA, 12));
+    }
+    sram0.setCrcMode(my23LC1024::CRC_MODE_OFF);
+    printf("  crc32 and crc16 checked\n");
+}
+
+// 25xx640A page bursts with WIP polling, at a typical and the worst case cycle time:
+static double __eepromRewrite__(const uint64_t cycleNs) {
+    eepromModel.writeTimeNs = cycleNs;
+    fillPattern(_bufferA, 8192, (uint8_t)cycleNs);
+    const uint64_t startNs = myHostSim::getTimeNs();
+    check("eeprom startWrite", eeprom.startWrite(0) == my25xx640A::NO_ERROR);
+    check("eeprom write", eeprom.write(_bufferA, 8192) == my25xx640A::NO_ERROR);
+    check("eeprom stop", eeprom.stop() == my25xx640A::NO_ERROR);
+    const double ms = elapsedMs(startNs);
+    check("eeprom data", memcmp(_bufferA, eepromModel.memory, 8192) == 0);
+    return ms;
+}
+
+static void benchEeprom() {
+    printf("25xx640A, full 8KB rewrite:\n");
+    const double typical = __eepromRewrite__(2000000);
+    const double worst = __eepromRewrite__(my25xx640AModel::WRITE_TIME_NS);
+    printf("  2ms cycle: %8.2f ms\n  5ms cycle: %8.2f ms\n", typical, worst);
+    check("polling follows the cycle time", typical < worst * 0.5);
+}
+
+// my23LC1024Cache, a flush the sram refuses leaves the lines dirty for the next one:
+static void checkCache() {
+    printf("23LC1024 cache:\n");
+    my23LC1024Cache cache(sram0);
+    fillPattern(_bufferA, 4096, 6);
+    memset(_bufferB, 0, 4096);
+    sram0.writeBuffer(0, _bufferB, 4096);
+    check("cache write", cache.write(100, _bufferA, 1000) == 1000);
+    check("cache read", cache.read(100, _bufferB, 1000) == 1000);
+    check("cache data", memcmp(_bufferA, _bufferB, 1000) == 0);
+    check("cache flush", cache.flush() == my23LC1024Cache::NO_ERROR);
+    check("cache flushed data", memcmp(&sramModel0.memory[100], _bufferA, 1000) == 0);
+    check("cache dirty line", cache.write(2048, &_bufferA[1000], 64) == 64);
+    check("cache start read", sram0.startRead(0) == my23LC1024::NO_ERROR);
+    check("cache flush busy", cache.flush() == my23LC1024::ERROR_SRAM_BUSY);
+    sram0.stop();
+    check("cache flush after busy", cache.flush() == my23LC1024Cache::NO_ERROR);
+    check("cache kept dirty line", memcmp(&sramModel0.memory[2048], &_bufferA[1000], 64) == 0);
+    printf("  %u write backs\n", cache.getStats().writeBacks);
+}
+
+// my23LC1024FIFO with a producer in a timer interrupt that lands in the consumer's burst:
+struct __fifoIrq__ {
+    my23LC1024FIFO *fifo;
+    const uint8_t *data;
+    int32_t length;
+    int32_t result;
+};
+
+static bool __fifoIrqPush__(repeating_timer_t *timer) {
+    __fifoIrq__ *irq = (__fifoIrq__ *)timer->user_data;
+    irq->result = irq->fifo->push(irq->data, irq->length);
+    return false;
+}
+
+static int32_t __fifoIrqDuringPop__(my23LC1024FIFO &fifo, const int32_t staged, const int32_t pushLength) {
+// Fill the ring, then the push stage to staged bytes, and push from the timer during a pop burst:
+    static uint8_t popped[my23LC1024FIFO::STAGE_SIZE];
+    fifo.push(_bufferA, my23LC1024FIFO::STAGE_SIZE);
+    fifo.flush();
+    fifo.push(_bufferA, staged);
+    __fifoIrq__ irq = { &fifo, _bufferA, pushLength, 1 };
+    repeating_timer_t timer;
+    add_repeating_timer_us(1, __fifoIrqPush__, &irq, &timer);
+    check("fifo pop during irq", fifo.pop(popped, my23LC1024FIFO::STAGE_SIZE) == my23LC1024FIFO::STAGE_SIZE);
+    check("fifo pop data", memcmp(popped, _bufferA, my23LC1024FIFO::STAGE_SIZE) == 0);
+    return irq.result;
+}
+
+static void checkFifo() {
+    printf("23LC1024 FIFO:\n");
+    fillPattern(_bufferA, 4096, 7);
+    uint64_t total = 0;
+    {
+        my23LC1024FIFO fifo(sram0, 0, 4096);
+        uint32_t pushed = 0, popped = 0;
+        bool inOrder = true;
+        for (int32_t round=0; round<200; round++) {
+            const int32_t length = 1 + (round * 37) % 700;
+            for (int32_t i=0; i<length; i++) { _bufferB[i] = (uint8_t)(pushed + i); }
+            const int32_t taken = fifo.push(_bufferB, length);
+            if (taken > 0) { pushed += taken; }
+            if (round % 5 == 0) { fifo.flush(); }
+            const int32_t got = fifo.pop(_bufferB, 500);
+            for (int32_t i=0; i<got; i++) { if (_bufferB[i] != (uint8_t)(popped + i)) { inOrder = false; } }
+            if (got > 0) { popped += got; }
+        }
+        fifo.flush();
+        int32_t got;
+        while ((got = fifo.pop(_bufferB, 500)) > 0) {
+            for (int32_t i=0; i<got; i++) { if (_bufferB[i] != (uint8_t)(popped + i)) { inOrder = false; } }
+            popped += got;
+        }
+        check("fifo in order", inOrder);
+        check("fifo all popped", popped == pushed);
+        total = pushed;
+    }
+    {
+    // A full stage has to burst, and the burst can't wait out the pop it interrupted:
+        my23LC1024FIFO fifo(sram0, 0, 4096);
+        check("fifo irq busy", __fifoIrqDuringPop__(fifo, my23LC1024FIFO::STAGE_SIZE, 1) == my23LC1024FIFO::ERROR_SRAM_BUSY);
+    }
+    {
+    // With room in the stage, the bytes staged before the burst are reported taken:
+        my23LC1024FIFO fifo(sram0, 0, 4096);
+        check("fifo irq partial", __fifoIrqDuringPop__(fifo, my23LC1024FIFO::STAGE_SIZE - 6, 10) == 6);
+        check("fifo retry", fifo.push(&_bufferA[6], 4) == 4);
+    }
+// Each FIFO gives its spin lock back, so this would panic if they leaked:
+    for (uint8_t i=0; i<NUM_SPIN_LOCKS; i++) { my23LC1024FIFO fifo(sram0, 0, 4096); }
+    printf("  %llu bytes in order\n", (unsigned long long)total);
+}
+
+// my23LC1024Heap allocation, compaction and data:
+static void checkHeap() {
+    printf("23LC1024 heap:\n");
+    my23LC1024Heap heap(sram0, 0, 4096);
+    int32_t handles[8];
+    bool written = true;
+    for (uint8_t i=0; i<8; i++) {
+        handles[i] = heap.alloc(500);
+        memset(_bufferA, i + 1, 500);
+        if (handles[i] < 0 or heap.write(handles[i], 0, _bufferA, 500) != 500) { written = false; }
+    }
+    check("heap alloc", written);
+    check("heap full", heap.alloc(1) < 0);
+    heap.free(handles[1]);
+    heap.free(handles[3]);
+    heap.free(handles[5]);
+    const int32_t big = heap.alloc(1500);
+    check("heap compacted alloc", big >= 0);
+    bool kept = true;
+    const uint8_t live[5] = { 0, 2, 4, 6, 7 };
+    for (uint8_t i=0; i<5; i++) {
+        heap.read(handles[live[i]], 0, _bufferB, 500);
+        for (int32_t j=0; j<500; j++) { if (_bufferB[j] != live[i] + 1) { kept = false; } }
+    }
+    check("heap data after compaction", kept);
+    printf("  %d bytes free\n", (int)heap.getFree());
+}
+
+// my25xx640ALog over the eeprom, a write cycle that times out is reported:
+static void checkLog() {
+    printf("25xx640A log:\n");
+    eepromModel.writeTimeNs = 2000000;
+    my25xx640ALog log(eeprom, 0, 8);
+    check("log format", log.format() == my25xx640ALog::NO_ERROR);
+    const uint8_t data[4] = { 1, 2, 3, 4 };
+    check("log append", log.append(3, data, 4) == my25xx640ALog::NO_ERROR);
+    check("log flush", log.flush() == my25xx640ALog::NO_ERROR);
+    uint8_t readBack[4];
+    my25xx640ALog remounted(eeprom, 0, 8);
+    check("log mount", remounted.mount() == my25xx640ALog::NO_ERROR);
+    check("log read", remounted.read(3, readBack, 4) == 4 and memcmp(readBack, data, 4) == 0);
+// A chip that never ends its cycle:
+    eepromModel.writeTimeNs = 100000000;
+    check("log append slow", log.append(4, data, 4) == my25xx640ALog::NO_ERROR);
+    check("log flush timeout", log.flush() == my25xx640A::ERROR_TIMEOUT);
+    eepromModel.writeTimeNs = 2000000;
+    sleep_ms(100);
+    printf("  timeout reported\n");
+}
+
+// AT24C32 ACK polling, the model uses the worst case cycle time:
+static void benchAT24C32() {
+    printf("AT24C32, full 4KB write:\n");
+    fillPattern(_bufferA, 4096, 4);
+    const uint64_t startNs = myHostSim::getTimeNs();
+    check("at24 write", at24.write(0, _bufferA, 4096) == myAT24C32::NO_ERROR);
+    const double ms = elapsedMs(startNs);
+// One read of the whole chip outlasts the driver's 50ms I2C timeout, read it back in 256 byte chunks:
+    int16_t readResult = myAT24C32::NO_ERROR;
+    for (uint16_t address = 0; address < 4096 and readResult == myAT24C32::NO_ERROR; address += 256) {
+        readResult = at24.read(address, _bufferB + address, 256);
+    }
+    check("at24 read", readResult == myAT24C32::NO_ERROR);
+    check("at24 data", memcmp(_bufferA, _bufferB, 4096) == 0);
+// A 10ms sleep before and after each page costs 2560ms on its own:
+    printf("  ack poll:  %8.2f ms, %u write cycles\n", ms, atModel.writeCycles);
+    check("128 write cycles", atModel.writeCycles == 128);
+    check("faster than sleeping", ms < 128 * 2 * 10);
+}
+
+/* ##################### Main: ##################### */
+int main() {
+    myHostSim::reset();
+    myHostSim::attachSpiDevice(spi0, 17, &sramModel0);
+    myHostSim::attachSpiDevice(spi1, 13, &sramModel1);
+    myHostSim::attachSpiDevice(spi0, 20, &sramModel2);
+    myHostSim::attachSpiDevice(spi0, 21, &eepromModel);
+    myHostSim::attachI2cDevice(i2c0, 0x50, &atModel);
+    check("sram0 initialize", sram0.initialize() == my23LC1024::NO_ERROR);
+    check("sram1 initialize", sram1.initialize() == my23LC1024::NO_ERROR);
+    check("sram2 initialize", sram2.initialize() == my23LC1024::NO_ERROR);
+    check("eeprom initialize", eeprom.initialize() == my25xx640A::NO_ERROR);
+    check("at24 initialize", at24.initialize() == myAT24C32::NO_ERROR);
+    if (_failures > 0) { return 1; }
+    benchBulk();
+    benchArray();
+    benchBatch();
+    benchExtArray();
+    benchScan();
+    benchCrc();
+    benchEeprom();
+    checkCache();
+    checkFifo();
+    checkHeap();
+    checkLog();
+    benchAT24C32();
+    printf("%d failed checks\n", _failures);
+    return (_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file myHelpersBench.cpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Host benchmark of the myHelpers bit reverse kernels against the bit loops they replaced.
+ * @version 0.1
+ * @date 2022-08-10
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Checks reverse8 / reverse16 and reverse8Buffer / reverse16Buffer against the old per bit loops
+ * for every input, and reverse32 / reverse32Buffer against a bit loop for every byte in every
+ * position plus a sample of words, then times the 8 and 16 bit kernels over a 64KB buffer with the
+ * host clock. The times are host times, they show the ratio between kernels, not what the M0+ will
+ * take. Exits with 1 if any check fails.
+ */
+#include <chrono>
+#include "../../myHelpers.hpp"
+
+static const size_t BUFFER_LENGTH = 65536;               // In bytes.
+static const int ROUNDS = 200;
+
+alignas(4) static uint8_t _src[BUFFER_LENGTH + 4];      // Room to run the kernels off alignment.
+alignas(4) static uint8_t _dst[BUFFER_LENGTH + 4];
+alignas(4) static uint8_t _ref[BUFFER_LENGTH + 4];
+static volatile uint32_t _sink;                          // Keeps the timed loops from being dropped.
+static int _failures = 0;
+
+/* ##################### Reference: ##################### */
+// The bit loops myHelpers used before the table and word at a time kernels:
+static uint8_t __oldReverse8__(const uint8_t value) {
+    uint8_t returnValue = 0x00;
+    for (uint8_t i=0; i<8; i++) {
+        returnValue <<= 1;
+        if ((bool)(value & (1<<i)) == true) {
+            returnValue |= 0x01;
+        }
+    }
+    return returnValue;
+}
+
+static uint16_t __oldReverse16__(const uint16_t value) {
+    uint16_t returnValue = 0x0000;
+    for (uint8_t i=0; i<16; i++) {
+        returnValue <<= 1;
+        if ((bool)(value& (1 << i)) == true) {
+            returnValue |= 0x01;
+        }
+    }
+    return returnValue;
+}
+
+// No 32 bit reverse before, the same loop at 32 bits:
+static uint32_t __loopReverse32__(const uint32_t value) {
+    uint32_t returnValue = 0x00000000;
+    for (uint8_t i=0; i<32; i++) {
+        returnValue <<= 1;
+        if ((bool)(value & (1u << i)) == true) {
+            returnValue |= 0x01;
+        }
+    }
+    return returnValue;
+}
+
+/* ##################### Helpers: ##################### */
+static void check(const char *name, const bool passed) {
+    if (passed == false) {
+        printf("  FAIL: %s\n", name);
+        _failures++;
+    }
+}
+
+static double nowMs() {
+    return std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint32_t checksum(const uint8_t *buffer, const size_t length) {
+    uint32_t sum = 0;
+    for (size_t i=0; i<length; i++) { sum = sum * 31 + buffer[i]; }
+    return sum;
+}
+
+/* ##################### Cases: ##################### */
+// Every input, and every buffer alignment the kernels branch on:
+static void checkKernels() {
+    bool passed = true;
+    for (uint32_t value=0; value<256; value++) {
+        if (myHelpers::reverse8((uint8_t)value) != __oldReverse8__((uint8_t)value)) { passed = false; }
+    }
+    check("reverse8", passed);
+    passed = true;
+    for (uint32_t value=0; value<65536; value++) {
+        if (myHelpers::reverse16((uint16_t)value) != __oldReverse16__((uint16_t)value)) { passed = false; }
+    }
+    check("reverse16", passed);
+    for (size_t i=0; i<BUFFER_LENGTH + 4; i++) { _src[i] = (uint8_t)(i * 7 + (i >> 8)); }
+    passed = true;
+    for (size_t srcOffset=0; srcOffset<4; srcOffset++) {
+        for (size_t dstOffset=0; dstOffset<4; dstOffset++) {
+            const size_t length = 1021;                  // Leaves a tail after the word loop.
+            for (size_t i=0; i<length; i++) { _ref[i] = __oldReverse8__(_src[srcOffset + i]); }
+            myHelpers::reverse8Buffer(&_dst[dstOffset], &_src[srcOffset], length);
+            if (memcmp(&_dst[dstOffset], _ref, length) != 0) { passed = false; }
+        }
+    }
+    check("reverse8Buffer", passed);
+    passed = true;
+    for (size_t srcOffset=0; srcOffset<4; srcOffset+=2) {
+        for (size_t dstOffset=0; dstOffset<4; dstOffset+=2) {
+            const size_t length = 509;                   // In half words.
+            const uint16_t *src = (const uint16_t *)&_src[srcOffset];
+            uint16_t *dst = (uint16_t *)&_dst[dstOffset];
+            uint16_t *ref = (uint16_t *)_ref;
+            for (size_t i=0; i<length; i++) { ref[i] = __oldReverse16__(src[i]); }
+            myHelpers::reverse16Buffer(dst, src, length);
+            if (memcmp(dst, ref, length * 2) != 0) { passed = false; }
+        }
+    }
+    check("reverse16Buffer", passed);
+// Every byte value in every byte position, over a background of zeros and of ones, then a sample:
+    passed = true;
+    for (uint8_t shift=0; shift<32; shift+=8) {
+        for (uint32_t value=0; value<256; value++) {
+            const uint32_t onZeros = value << shift;
+            const uint32_t onOnes = ~(0xFFu << shift) | onZeros;
+            if (myHelpers::reverse32(onZeros) != __loopReverse32__(onZeros)) { passed = false; }
+            if (myHelpers::reverse32(onOnes) != __loopReverse32__(onOnes)) { passed = false; }
+        }
+    }
+    uint32_t sample = 1;
+    for (uint32_t i=0; i<1000000; i++) {
+        sample = sample * 1664525u + 1013904223u;
+        if (myHelpers::reverse32(sample) != __loopReverse32__(sample)) { passed = false; }
+    }
+    check("reverse32", passed);
+    const size_t words = 1021;
+    const uint32_t *src = (const uint32_t *)_src;
+    uint32_t *dst = (uint32_t *)_dst;
+    uint32_t *ref = (uint32_t *)_ref;
+    for (size_t i=0; i<words; i++) { ref[i] = __loopReverse32__(src[i]); }
+    myHelpers::reverse32Buffer(dst, src, words);
+    check("reverse32Buffer", memcmp(dst, ref, words * 4) == 0);
+// In place:
+    memcpy(_dst, _src, BUFFER_LENGTH);
+    myHelpers::reverse8Buffer(_dst, BUFFER_LENGTH);
+    myHelpers::reverse8Buffer(_dst, BUFFER_LENGTH);
+    check("reverse8Buffer in place", memcmp(_dst, _src, BUFFER_LENGTH) == 0);
+    myHelpers::reverse32Buffer(dst, words);
+    check("reverse32Buffer in place", memcmp(dst, ref, words * 4) == 0);
+}
+
+static void bench8() {
+    printf("8 bit reverse, 64KB x %d:\n", ROUNDS);
+    double startMs = nowMs();
+    for (int round=0; round<ROUNDS; round++) {
+        for (size_t i=0; i<BUFFER_LENGTH; i++) { _ref[i] = __oldReverse8__(_src[i]); }
+        _sink = _sink + _ref[round];
+    }
+    const double oldMs = nowMs() - startMs;
+    startMs = nowMs();
+    for (int round=0; round<ROUNDS; round++) {
+        for (size_t i=0; i<BUFFER_LENGTH; i++) { _dst[i] = myHelpers::reverse8(_src[i]); }
+        _sink = _sink + _dst[round];
+    }
+    const double tableMs = nowMs() - startMs;
+    startMs = nowMs();
+    for (int round=0; round<ROUNDS; round++) {
+        myHelpers::reverse8Buffer(_dst, _src, BUFFER_LENGTH);
+        _sink = _sink + _dst[round];
+    }
+    const double bufferMs = nowMs() - startMs;
+    printf("  bit loop:       %8.2f ms\n", oldMs);
+    printf("  table:          %8.2f ms (%.1fx)\n", tableMs, oldMs / tableMs);
+    printf("  reverse8Buffer: %8.2f ms (%.1fx)\n", bufferMs, oldMs / bufferMs);
+    check("reverse8Buffer data", checksum(_dst, BUFFER_LENGTH) == checksum(_ref, BUFFER_LENGTH));
+}
+
+static void bench16() {
+    const size_t length = BUFFER_LENGTH / 2;
+    const uint16_t *src = (const uint16_t *)_src;
+    uint16_t *dst = (uint16_t *)_dst;
+    uint16_t *ref = (uint16_t *)_ref;
+    printf("16 bit reverse, 64KB x %d:\n", ROUNDS);
+    double startMs = nowMs();
+    for (int round=0; round<ROUNDS; round++) {
+        for (size_t i=0; i<length; i++) { ref[i] = __oldReverse16__(src[i]); }
+        _sink = _sink + ref[round];
+    }
+    const double oldMs = nowMs() - startMs;
+    startMs = nowMs();
+    for (int round=0; round<ROUNDS; round++) {
+        for (size_t i=0; i<length; i++) { dst[i] = myHelpers::reverse16(src[i]); }
+        _sink = _sink + dst[round];
+    }
+    const double tableMs = nowMs() - startMs;
+    startMs = nowMs();
+    for (int round=0; round<ROUNDS; round++) {
+        myHelpers::reverse16Buffer(dst, src, length);
+        _sink = _sink + dst[round];
+    }
+    const double bufferMs = nowMs() - startMs;
+    printf("  bit loop:        %8.2f ms\n", oldMs);
+    printf("  table:           %8.2f ms (%.1fx)\n", tableMs, oldMs / tableMs);
+    printf("  reverse16Buffer: %8.2f ms (%.1fx)\n", bufferMs, oldMs / bufferMs);
+    check("reverse16Buffer data", checksum(_dst, BUFFER_LENGTH) == checksum(_ref, BUFFER_LENGTH));
+}
+
+/* ##################### Main: ##################### */
+int main() {
+    checkKernels();
+    if (_failures > 0) { return 1; }
+    bench8();
+    bench16();
+    printf("%d failed checks\n", _failures);
+    return (_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,5 @@
+/**
+ * @file adc.h
+ * @brief Host side stand in for the pico-sdk <hardware/adc.h>.
+ */
+#include "../../myHostSim.hpp"
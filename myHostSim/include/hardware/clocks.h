@@ -0,0 +1,5 @@
+/**
+ * @file clocks.h
+ * @brief Host side stand in for the pico-sdk <hardware/clocks.h>.
+ */
+#include "../../myHostSim.hpp"
@@ -0,0 +1,5 @@
+/**
+ * @file dma.h
+ * @brief Host side stand in for the pico-sdk <hardware/dma.h>.
+ */
+#include "../../myHostSim.hpp"
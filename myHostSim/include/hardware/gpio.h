@@ -0,0 +1,5 @@
+/**
+ * @file gpio.h
+ * @brief Host side stand in for the pico-sdk <hardware/gpio.h>.
+ */
+#include "../../myHostSim.hpp"
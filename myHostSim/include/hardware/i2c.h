@@ -0,0 +1,5 @@
+/**
+ * @file i2c.h
+ * @brief Host side stand in for the pico-sdk <hardware/i2c.h>.
+ */
+#include "../../myHostSim.hpp"
@@ -0,0 +1,5 @@
+/**
+ * @file irq.h
+ * @brief Host side stand in for the pico-sdk <hardware/irq.h>.
+ */
+#include "../../myHostSim.hpp"
@@ -0,0 +1,5 @@
+/**
+ * @file pio.h
+ * @brief Host side stand in for the pico-sdk <hardware/pio.h>.
+ */
+#include "../../myHostSim.hpp"
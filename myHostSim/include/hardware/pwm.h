@@ -0,0 +1,5 @@
+/**
+ * @file pwm.h
+ * @brief Host side stand in for the pico-sdk <hardware/pwm.h>.
+ */
+#include "../../myHostSim.hpp"
@@ -0,0 +1,5 @@
+/**
+ * @file spi.h
+ * @brief Host side stand in for the pico-sdk <hardware/spi.h>.
+ */
+#include "../../myHostSim.hpp"
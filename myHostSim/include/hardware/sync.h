@@ -0,0 +1,5 @@
+/**
+ * @file sync.h
+ * @brief Host side stand in for the pico-sdk <hardware/sync.h>.
+ */
+#include "../../myHostSim.hpp"
@@ -0,0 +1,5 @@
+/**
+ * @file timer.h
+ * @brief Host side stand in for the pico-sdk <hardware/timer.h>.
+ */
+#include "../../myHostSim.hpp"
@@ -0,0 +1,15 @@
+/**
+ * @file my23LC1024.pio.h
+ * @brief Host side stand in for the header pioasm generates from my23LC1024/my23LC1024.pio.
+ * PIO isn't emulated, pio_can_add_program() always fails, so the driver bit bangs SDI and SQI.
+ */
+#ifndef MY_HOST_SIM_MY23LC1024_PIO_H
+#define MY_HOST_SIM_MY23LC1024_PIO_H
+#include "../myHostSim.hpp"
+
+static const pio_program_t my23LC1024_sdi_program = { nullptr, 0, -1 };
+static const pio_program_t my23LC1024_sqi_program = { nullptr, 0, -1 };
+
+static inline pio_sm_config my23LC1024_sdi_program_get_default_config(const uint offset) { return pio_get_default_sm_config(); }
+static inline pio_sm_config my23LC1024_sqi_program_get_default_config(const uint offset) { return pio_get_default_sm_config(); }
+#endif
@@ -0,0 +1,5 @@
+/**
+ * @file error.h
+ * @brief Host side stand in for the pico-sdk <pico/error.h>.
+ */
+#include "../../myHostSim.hpp"
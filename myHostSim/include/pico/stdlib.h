@@ -0,0 +1,5 @@
+/**
+ * @file stdlib.h
+ * @brief Host side stand in for the pico-sdk <pico/stdlib.h>.
+ */
+#include "../../myHostSim.hpp"
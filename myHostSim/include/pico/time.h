@@ -0,0 +1,5 @@
+/**
+ * @file time.h
+ * @brief Host side stand in for the pico-sdk <pico/time.h>.
+ */
+#include "../../myHostSim.hpp"
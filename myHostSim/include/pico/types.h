@@ -0,0 +1,5 @@
+/**
+ * @file types.h
+ * @brief Host side stand in for the pico-sdk <pico/types.h>.
+ */
+#include "../../myHostSim.hpp"
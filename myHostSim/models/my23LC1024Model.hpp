@@ -0,0 +1,76 @@
+/**
+ * @file my23LC1024Model.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Host side model of the 23LC1024 SPI SRAM.
+ * @version 0.1
+ * @date 2022-08-08
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY_23LC1024_MODEL_H
+#define MY_23LC1024_MODEL_H
+
+#include "../myHostSim.hpp"
+/**
+ * @brief Model of the 23LC1024 SPI SRAM.
+ * Implements READ, WRITE, RDMR and WRMR, in byte, page and sequential modes, in SPI comms mode.
+ */
+class my23LC1024Model : public myHostSim::spiDevice {
+    public:
+        static const uint32_t SIZE = 128 * 1024;
+        static const uint32_t PAGE_SIZE = 32;
+        uint8_t memory[SIZE];               // Contents, free for the host to inspect.
+        uint8_t mode = 0x40;                // Mode register, sequential on power up.
+
+        my23LC1024Model() {
+            memset(memory, 0, sizeof(memory));
+        }
+        void select() override {
+            _count = 0;
+        }
+        uint8_t transfer(const uint8_t mosi) override {
+            const uint32_t index = _count++;
+            if (index == 0) {
+                _instruction = mosi;
+                _address = 0;
+                return 0x00;
+            }
+            switch (_instruction) {
+                case 0x05:                  // RDMR.
+                    return mode;
+                case 0x01:                  // WRMR.
+                    if (index == 1) { mode = mosi; }
+                    return 0x00;
+                case 0x02:                  // WRITE.
+                case 0x03:                  // READ.
+                    if (index <= 3) {
+                        _address = ((_address << 8) | mosi) & (SIZE - 1);
+                        return 0x00;
+                    }
+                    if ((mode & 0xC0) == 0x00 and index > 4) { return 0x00; }   // Byte mode.
+                    {
+                        const uint8_t value = memory[_address];
+                        if (_instruction == 0x02) { memory[_address] = mosi; }
+                        __increment__();
+                        return (_instruction == 0x03) ? value : 0x00;
+                    }
+                default:
+                    return 0x00;
+            }
+        }
+
+    private:
+        uint32_t _count = 0;
+        uint8_t _instruction = 0x00;
+        uint32_t _address = 0;
+
+        void __increment__() {
+            if ((mode & 0xC0) == 0x80) {    // Page mode wraps within the page.
+                _address = (_address & ~(PAGE_SIZE - 1)) | ((_address + 1) & (PAGE_SIZE - 1));
+            } else {
+                _address = (_address + 1) & (SIZE - 1);
+            }
+        }
+};
+#endif
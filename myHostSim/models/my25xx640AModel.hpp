@@ -0,0 +1,101 @@
+/**
+ * @file my25xx640AModel.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Host side model of the 25xx640A SPI EEPROM.
+ * @version 0.1
+ * @date 2022-08-08
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY_25XX640A_MODEL_H
+#define MY_25XX640A_MODEL_H
+
+#include "../myHostSim.hpp"
+/**
+ * @brief Model of the 25xx640A SPI EEPROM.
+ * Implements READ, WRITE, WREN, WRDI, RDSR and WRSR. Writes wrap within their page, and start a
+ * write cycle when chip select rises, during which only RDSR is accepted.
+ */
+class my25xx640AModel : public myHostSim::spiDevice {
+    public:
+        static const uint32_t SIZE = 8 * 1024;
+        static const uint32_t PAGE_SIZE = 32;
+        static const uint64_t WRITE_TIME_NS = 5000000;
+        uint8_t memory[SIZE];               // Contents, free for the host to inspect.
+        uint8_t status = 0x00;              // Status register, without WIP.
+        uint32_t writeCycles = 0;           // Number of write cycles started.
+        uint64_t writeTimeNs = WRITE_TIME_NS;   // Length of a write cycle, worst case by default.
+
+        my25xx640AModel() {
+            memset(memory, 0xFF, sizeof(memory));
+        }
+        bool isBusy() {
+            return myHostSim::getTimeNs() < _busyUntilNs;
+        }
+        void select() override {
+            _count = 0;
+            _pending = 0;
+        }
+        uint8_t transfer(const uint8_t mosi) override {
+            const uint32_t index = _count++;
+            if (index == 0) {
+                _instruction = mosi;
+                _address = 0;
+                if (isBusy() == true and _instruction != 0x05) { _instruction = 0x00; }   // Ignored.
+                if (_instruction == 0x06) { status |= 0x02; }       // WREN.
+                if (_instruction == 0x04) { status &= ~0x02; }      // WRDI.
+                return 0x00;
+            }
+            switch (_instruction) {
+                case 0x05:                                          // RDSR.
+                    return status | (isBusy() ? 0x01 : 0x00);
+                case 0x01:                                          // WRSR.
+                    if (index == 1 and (status & 0x02) != 0) {
+                        status = (status & 0x03) | (mosi & 0x8C);
+                        _pending = 1;
+                    }
+                    return 0x00;
+                case 0x03:                                          // READ.
+                    if (index <= 2) {
+                        _address = ((_address << 8) | mosi) & (SIZE - 1);
+                        return 0x00;
+                    } else {
+                        const uint8_t value = memory[_address];
+                        _address = (_address + 1) & (SIZE - 1);
+                        return value;
+                    }
+                case 0x02:                                          // WRITE.
+                    if (index <= 2) {
+                        _address = ((_address << 8) | mosi) & (SIZE - 1);
+                        return 0x00;
+                    }
+                    if ((status & 0x02) == 0) { return 0x00; }
+                    _page[_pending % PAGE_SIZE] = { _address, mosi };
+                    if (_pending < PAGE_SIZE) { _pending++; }
+                    _address = (_address & ~(PAGE_SIZE - 1)) | ((_address + 1) & (PAGE_SIZE - 1));
+                    return 0x00;
+                default:
+                    return 0x00;
+            }
+        }
+        void deselect() override {
+            if ((_instruction != 0x02 and _instruction != 0x01) or _pending == 0) { return; }
+            if (_instruction == 0x02) {
+                for (uint32_t i=0; i<_pending; i++) { memory[_page[i].first] = _page[i].second; }
+            }
+            status &= ~0x02;
+            _busyUntilNs = myHostSim::getTimeNs() + writeTimeNs;
+            writeCycles++;
+            _pending = 0;
+        }
+
+    private:
+        uint32_t _count = 0;
+        uint8_t _instruction = 0x00;
+        uint32_t _address = 0;
+        std::pair<uint32_t, uint8_t> _page[PAGE_SIZE];
+        uint32_t _pending = 0;
+        uint64_t _busyUntilNs = 0;
+};
+#endif
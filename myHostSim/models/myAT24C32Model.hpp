@@ -0,0 +1,72 @@
+/**
+ * @file myAT24C32Model.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Host side model of the AT24C32 I2C EEPROM.
+ * @version 0.1
+ * @date 2022-08-08
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY_AT24C32_MODEL_H
+#define MY_AT24C32_MODEL_H
+
+#include "../myHostSim.hpp"
+/**
+ * @brief Model of the AT24C32 I2C EEPROM.
+ * A write sets the address from its first two bytes, and buffers the rest within the page. A
+ * write ending in a stop starts a write cycle, during which the address is not acknowledged.
+ */
+class myAT24C32Model : public myHostSim::i2cDevice {
+    public:
+        static const uint32_t SIZE = 4 * 1024;
+        static const uint32_t PAGE_SIZE = 32;
+        static const uint64_t WRITE_TIME_NS = 10000000;
+        uint8_t memory[SIZE];               // Contents, free for the host to inspect.
+        uint32_t writeCycles = 0;           // Number of write cycles started.
+        uint32_t naks = 0;                  // Addresses not acknowledged while busy.
+
+        myAT24C32Model() {
+            memset(memory, 0xFF, sizeof(memory));
+        }
+        bool isBusy() {
+            return myHostSim::getTimeNs() < _busyUntilNs;
+        }
+        int write(const uint8_t *src, const size_t len, const bool nostop) override {
+            if (isBusy() == true) {
+                naks++;
+                return PICO_ERROR_GENERIC;
+            }
+            uint32_t pending = 0;
+            for (size_t i=0; i<len; i++) {
+                if (i < 2) {
+                    _address = ((_address << 8) | src[i]) & (SIZE - 1);
+                    continue;
+                }
+                memory[_address] = src[i];
+                _address = (_address & ~(PAGE_SIZE - 1)) | ((_address + 1) & (PAGE_SIZE - 1));
+                pending++;
+            }
+            if (pending > 0 and nostop == false) {
+                _busyUntilNs = myHostSim::getTimeNs() + WRITE_TIME_NS;
+                writeCycles++;
+            }
+            return (int)len;
+        }
+        int read(uint8_t *dst, const size_t len, const bool nostop) override {
+            if (isBusy() == true) {
+                naks++;
+                return PICO_ERROR_GENERIC;
+            }
+            for (size_t i=0; i<len; i++) {
+                dst[i] = memory[_address];
+                _address = (_address + 1) & (SIZE - 1);
+            }
+            return (int)len;
+        }
+
+    private:
+        uint32_t _address = 0;
+        uint64_t _busyUntilNs = 0;
+};
+#endif
@@ -0,0 +1,1332 @@
+/**
+ * @file myHostSim.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Host side emulation of the pico-sdk calls used by pico-myLibs.
+ * @version 0.1
+ * @date 2022-08-08
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY_HOST_SIM_H
+#define MY_HOST_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+/*
+ * ############################ SDK types and defines: ############################
+ */
+typedef unsigned int uint;
+typedef volatile uint32_t io_rw_32;
+typedef volatile uint32_t io_ro_32;
+typedef volatile uint32_t io_wo_32;
+typedef uint64_t absolute_time_t;
+/** @private */
+typedef struct {
+    int16_t year;
+    int8_t month;
+    int8_t day;
+    int8_t dotw;
+    int8_t hour;
+    int8_t min;
+    int8_t sec;
+} datetime_t;
+
+#ifndef MIN
+    #define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+    #define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define __not_in_flash_func(x) x
+#define __time_critical_func(x) x
+#define __isr
+
+enum pico_error_codes {
+    PICO_OK = 0,
+    PICO_ERROR_NONE = 0,
+    PICO_ERROR_TIMEOUT = -1,
+    PICO_ERROR_GENERIC = -2,
+    PICO_ERROR_NO_DATA = -3,
+};
+// GPIO:
+#define GPIO_OUT 1
+#define GPIO_IN 0
+enum gpio_function {
+    GPIO_FUNC_XIP = 0, GPIO_FUNC_SPI = 1, GPIO_FUNC_UART = 2, GPIO_FUNC_I2C = 3, GPIO_FUNC_PWM = 4,
+    GPIO_FUNC_SIO = 5, GPIO_FUNC_PIO0 = 6, GPIO_FUNC_PIO1 = 7, GPIO_FUNC_GPCK = 8, GPIO_FUNC_USB = 9,
+    GPIO_FUNC_NULL = 0x1f,
+};
+enum gpio_irq_level {
+    GPIO_IRQ_LEVEL_LOW = 0x1u, GPIO_IRQ_LEVEL_HIGH = 0x2u, GPIO_IRQ_EDGE_FALL = 0x4u, GPIO_IRQ_EDGE_RISE = 0x8u,
+};
+typedef void (*irq_handler_t)(void);
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+// IRQ numbers:
+#define TIMER_IRQ_0 0
+#define PIO0_IRQ_0 7
+#define PIO0_IRQ_1 8
+#define PIO1_IRQ_0 9
+#define PIO1_IRQ_1 10
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+#define IO_IRQ_BANK0 13
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+#define PICO_SHARED_IRQ_HANDLER_HIGHEST_ORDER_PRIORITY 0xff
+#define PICO_SHARED_IRQ_HANDLER_LOWEST_ORDER_PRIORITY 0x00
+// SPI:
+typedef enum { SPI_CPHA_0 = 0, SPI_CPHA_1 = 1 } spi_cpha_t;
+typedef enum { SPI_CPOL_0 = 0, SPI_CPOL_1 = 1 } spi_cpol_t;
+typedef enum { SPI_LSB_FIRST = 0, SPI_MSB_FIRST = 1 } spi_order_t;
+/** @private */
+typedef struct { io_rw_32 cr0, cr1, dr, sr, cpsr, imsc, ris, mis, icr, dmacr; } spi_hw_t;
+/** @private */
+typedef struct spi_inst spi_inst_t;
+// I2C:
+/** @private */
+typedef struct i2c_inst { uint8_t index; } i2c_inst_t;
+// DMA:
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+#define NUM_DMA_CHANNELS 12
+#define DREQ_SPI0_TX 16
+#define DREQ_SPI0_RX 17
+#define DREQ_SPI1_TX 18
+#define DREQ_SPI1_RX 19
+#define DREQ_FORCE 0x3f
+/** @private */
+typedef struct {
+    uint8_t size;
+    bool readIncrement;
+    bool writeIncrement;
+    uint dreq;
+    uint8_t ringBits;
+    bool ringWrite;
+    uint chainTo;
+    bool irqQuiet;
+    bool enable;
+    bool sniff;
+    bool bswap;
+} dma_channel_config;
+/** @private */
+typedef struct {
+    volatile uintptr_t read_addr;           // Host pointers don't fit the 32 bit registers.
+    volatile uintptr_t write_addr;
+    io_rw_32 transfer_count;
+    io_rw_32 ctrl_trig;
+} dma_channel_hw_t;
+/** @private */
+typedef struct {
+    dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+    io_rw_32 ints0;
+    io_rw_32 inte0;
+    io_rw_32 ints1;
+    io_rw_32 inte1;
+    io_rw_32 sniff_ctrl;
+    io_rw_32 sniff_data;
+} dma_hw_t;
+// PIO:
+#define NUM_PIO_STATE_MACHINES 4
+#define PIO_FDEBUG_TXSTALL_LSB 24
+/** @private */
+typedef struct {
+    io_rw_32 ctrl, fstat, fdebug, flevel;
+    io_wo_32 txf[NUM_PIO_STATE_MACHINES];
+    io_ro_32 rxf[NUM_PIO_STATE_MACHINES];
+} pio_hw_t;
+typedef pio_hw_t *PIO;
+/** @private */
+typedef struct {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+/** @private */
+typedef struct { uint32_t clkdiv, execctrl, shiftctrl, pinctrl; } pio_sm_config;
+// Clocks:
+enum clock_index { clk_gpout0 = 0, clk_gpout1, clk_gpout2, clk_gpout3, clk_ref, clk_sys, clk_peri, clk_usb, clk_adc, clk_rtc };
+// Sync:
+typedef volatile uint32_t spin_lock_t;
+#define NUM_SPIN_LOCKS 32
+// Timers:
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+/** @private */
+struct repeating_timer {
+    int64_t delay_us;
+    void *pool;
+    int32_t alarm_id;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+
+/**
+ * @brief Host side emulation of the pico-sdk.
+ * Implements the SDK calls used by pico-myLibs on top of a virtual clock, so the driver headers
+ * compile and run unmodified on a Linux host. SPI devices are attached by chip select pin, and I2C
+ * devices by address. Bus transfers advance the clock by their time on the wire at the configured
+ * baud rate, CPU time is free, except for a small step in busy wait loops so they make progress.
+ * DMA transfers move their data when started, and complete, raising their interrupt, once the clock
+ * reaches the end of their time on the wire. Interrupts are delivered when the clock advances
+ * with interrupts enabled.
+ * @note Put myHostSim/include ahead of the SDK on the include path, and build for the host.
+ */
+namespace myHostSim {
+/*
+ * ############################ Device models: ############################
+ */
+    /**
+     * @brief SPI device model.
+     * Attached to a port and a chip select pin with attachSpiDevice(). Sees every byte on the bus
+     * while its chip select pin is low.
+     */
+    class spiDevice {
+        public:
+            virtual ~spiDevice() {}
+            /**
+             * @brief Chip select went low.
+             */
+            virtual void select() {}
+            /**
+             * @brief Exchange a byte.
+             * @param mosi Byte from the master.
+             * @return uint8_t Byte to the master.
+             */
+            virtual uint8_t transfer(const uint8_t mosi) = 0;
+            /**
+             * @brief Chip select went high.
+             */
+            virtual void deselect() {}
+    };
+    /**
+     * @brief I2C device model.
+     * Attached to a port and an address with attachI2cDevice().
+     */
+    class i2cDevice {
+        public:
+            virtual ~i2cDevice() {}
+            /**
+             * @brief Master write.
+             * @param src Data written, without the address.
+             * @param len Length of data.
+             * @param nostop True if the master keeps the bus.
+             * @return int Bytes acknowledged, or PICO_ERROR_GENERIC to NAK the address.
+             */
+            virtual int write(const uint8_t *src, const size_t len, const bool nostop) = 0;
+            /**
+             * @brief Master read.
+             * @param dst Buffer for the data.
+             * @param len Length of data.
+             * @param nostop True if the master keeps the bus.
+             * @return int Bytes read, or PICO_ERROR_GENERIC to NAK the address.
+             */
+            virtual int read(uint8_t *dst, const size_t len, const bool nostop) = 0;
+    };
+/*
+ * ############################ Types: ############################
+ */
+    /**
+     * @brief Bus counters.
+     * Per port, returned by getSpiCounters() and getI2cCounters().
+     */
+    struct busCounters_t {
+        uint64_t bytes = 0;                 // Bytes on the wire, excluding I2C addresses.
+        uint32_t calls = 0;                 // Transfer calls, and DMA transfers.
+        uint32_t transactions = 0;          // SPI chip select cycles carrying data, I2C transfers ending in a stop.
+        uint64_t busyNs = 0;                // Time on the wire.
+    };
+/*
+ * ############################ Constants: ############################
+ */
+    /** @private */
+    static const uint8_t _NUM_PINS = 30;
+    /** @private */
+    static const uint64_t _POLL_STEP_NS = 100;                     // Clock step per busy wait poll.
+/*
+ * ############################ Variables: ############################
+ */
+    /** @private */
+    struct __spiDevice__ {
+        uint8_t csPin;
+        spiDevice *device;
+        uint64_t bytesAtSelect;
+    };
+    /** @private */
+    struct __spiPort__ {
+        uint32_t baudRate = 0;
+        uint8_t dataBits = 8;
+        bool slave = false;
+        std::vector<__spiDevice__> devices;
+        busCounters_t counters;
+    };
+    /** @private */
+    struct __i2cPort__ {
+        uint32_t baudRate = 0;
+        std::vector<std::pair<uint8_t, i2cDevice *>> devices;
+        busCounters_t counters;
+    };
+    /** @private */
+    struct __dmaChannel__ {
+        bool claimed = false;
+        dma_channel_config config;
+        bool busy = false;                  // Triggered, and not complete.
+        bool started = false;               // Data moved, completes at doneNs.
+        uint64_t doneNs = 0;
+        bool irq0Enabled = false;
+    };
+    /** @private */
+    struct __timer__ {
+        repeating_timer_t *timer;
+        uint64_t dueNs;
+    };
+    /** @private */
+    uint64_t _nowNs = 0;
+    /** @private */
+    bool _irqsEnabled = true;
+    /** @private */
+    bool _inIrq = false;
+    /** @private */
+    uint8_t _coreNum = 0;
+// GPIO:
+    /** @private */
+    uint32_t _gpioOut = 0;
+    /** @private */
+    uint32_t _gpioDir = 0;
+    /** @private */
+    uint32_t _gpioIn = 0;                   // Levels driven by the host.
+    /** @private */
+    uint32_t _gpioDriven = 0;               // Pins driven by the host.
+    /** @private */
+    uint32_t _gpioPullUp = 0;
+    /** @private */
+    uint8_t _gpioFunction[_NUM_PINS];
+    /** @private */
+    uint32_t _gpioIrqEnabled[_NUM_PINS];
+    /** @private */
+    uint32_t _gpioIrqStatus[_NUM_PINS];
+    /** @private */
+    irq_handler_t _gpioRawHandlers[_NUM_PINS];
+    /** @private */
+    gpio_irq_callback_t _gpioCallback = nullptr;
+// IRQ:
+    /** @private */
+    uint32_t _irqEnabled = 0;
+    /** @private */
+    std::vector<irq_handler_t> _irqHandlers[32];
+// SPI:
+    /** @private */
+    spi_hw_t _spiHw[2];
+    /** @private */
+    __spiPort__ _spiPorts[2];
+// I2C:
+    /** @private */
+    __i2cPort__ _i2cPorts[2];
+// DMA:
+    /** @private */
+    dma_hw_t _dmaHw;
+    /** @private */
+    __dmaChannel__ _dmaChannels[NUM_DMA_CHANNELS];
+// Sync:
+    /** @private */
+    spin_lock_t _spinLocks[NUM_SPIN_LOCKS];
+    /** @private */
+    uint32_t _spinLocksClaimed = 0;
+// Timers:
+    /** @private */
+    std::vector<__timer__> _timers;
+// ADC:
+    /** @private */
+    uint16_t _adcValues[5];
+    /** @private */
+    uint8_t _adcInput = 0;
+// PWM:
+    /** @private */
+    uint16_t _pwmWraps[8];
+    /** @private */
+    uint16_t _pwmLevels[8][2];
+    /** @private */
+    bool _pwmEnabled[8];
+
+/*
+ * ############################ Private functions: ############################
+ */
+    void __service__();
+    /** @private */
+    uint32_t inline __padLevels__() {
+        const uint32_t inputs = (_gpioIn & _gpioDriven) | (_gpioPullUp & ~_gpioDriven);
+        return (_gpioOut & _gpioDir) | (inputs & ~_gpioDir);
+    }
+    /** @private */
+    void __padsChanged__(const uint32_t before) {
+        const uint32_t after = __padLevels__();
+        const uint32_t changed = before ^ after;
+        if (changed == 0) { return; }
+        for (uint8_t pin=0; pin<_NUM_PINS; pin++) {
+            if ((changed & (1u << pin)) == 0) { continue; }
+            const bool level = (after >> pin) & 1u;
+            const uint32_t event = (level == true) ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+            _gpioIrqStatus[pin] |= (event & _gpioIrqEnabled[pin]);
+        // Chip selects:
+            for (uint8_t port=0; port<2; port++) {
+                __spiPort__ &spiPort = _spiPorts[port];
+                for (auto &device : spiPort.devices) {
+                    if (device.csPin != pin) { continue; }
+                    if (level == false) {
+                        device.bytesAtSelect = spiPort.counters.bytes;
+                        device.device->select();
+                    } else {
+                        device.device->deselect();
+                        if (spiPort.counters.bytes != device.bytesAtSelect) { spiPort.counters.transactions++; }
+                    }
+                }
+            }
+        }
+        __service__();
+    }
+    /** @private */
+    uint16_t __spiFrame__(const uint8_t port, const uint16_t txFrame) {
+        __spiPort__ &spiPort = _spiPorts[port];
+        const uint8_t frameBytes = (spiPort.dataBits > 8) ? 2 : 1;
+        const uint32_t levels = __padLevels__();
+        uint16_t rxFrame = 0;
+        for (uint8_t i=0; i<frameBytes; i++) {
+            const uint8_t shift = 8 * (frameBytes - 1 - i);
+            const uint8_t mosi = (uint8_t)(txFrame >> shift);
+            uint8_t miso = 0xFF;                                    // Nothing driving MISO.
+            for (auto &device : spiPort.devices) {
+                if ((levels & (1u << device.csPin)) == 0) { miso = device.device->transfer(mosi); }
+            }
+            rxFrame |= (uint16_t)(miso << shift);
+        }
+        spiPort.counters.bytes += frameBytes;
+        return rxFrame;
+    }
+    /** @private */
+    uint64_t inline __spiTimeNs__(const uint8_t port, const size_t frames) {
+        const __spiPort__ &spiPort = _spiPorts[port];
+        const uint8_t frameBytes = (spiPort.dataBits > 8) ? 2 : 1;
+        if (spiPort.baudRate == 0) { return 0; }
+        return ((uint64_t)frames * frameBytes * 8 * 1000000000ull) / spiPort.baudRate;
+    }
+    /** @private */
+    void inline __advance__(const uint64_t ns) {
+        _nowNs += ns;
+        __service__();
+    }
+    /** @private */
+    uintptr_t inline __ringStep__(const uintptr_t addr, const uint8_t step, const uint8_t ringBits) {
+        if (ringBits == 0) { return addr + step; }
+        const uintptr_t mask = (1u << ringBits) - 1;
+        return (addr & ~mask) | ((addr + step) & mask);
+    }
+    /** @private */
+    uint32_t inline __dmaRead__(const uintptr_t addr, const uint8_t size) {
+        if (size == 1) { return *(volatile uint8_t *)addr; }
+        if (size == 2) { return *(volatile uint16_t *)addr; }
+        return *(volatile uint32_t *)addr;
+    }
+    /** @private */
+    void inline __dmaWrite__(const uintptr_t addr, const uint8_t size, const uint32_t value) {
+        if (size == 1) { *(volatile uint8_t *)addr = (uint8_t)value; }
+        else if (size == 2) { *(volatile uint16_t *)addr = (uint16_t)value; }
+        else { *(volatile uint32_t *)addr = value; }
+    }
+    /** @private */
+    int8_t inline __spiPortOfDreq__(const uint dreq, const bool tx) {
+        if (dreq == (tx ? DREQ_SPI0_TX : DREQ_SPI0_RX)) { return 0; }
+        if (dreq == (tx ? DREQ_SPI1_TX : DREQ_SPI1_RX)) { return 1; }
+        return -1;
+    }
+    /** @private */
+    void __sniff__(const uint channel, const uint8_t size, const uint32_t value) {
+        const uint32_t ctrl = _dmaHw.sniff_ctrl;
+        if ((ctrl & 0x01) == 0 or ((ctrl >> 1) & 0x0F) != channel) { return; }
+        if (_dmaChannels[channel].config.sniff == false) { return; }
+        const uint8_t calc = (uint8_t)((ctrl >> 5) & 0x0F);
+        uint32_t data = _dmaHw.sniff_data;
+        for (uint8_t i=0; i<size; i++) {    // Bytes in bus order, lowest first.
+            uint8_t byte = (uint8_t)(value >> (8 * i));
+            if (calc == 0x1 or calc == 0x3) {   // Bit reversed data.
+                uint8_t reversed = 0;
+                for (uint8_t bit=0; bit<8; bit++) { if (byte & (1u << bit)) { reversed |= (uint8_t)(0x80 >> bit); } }
+                byte = reversed;
+            }
+            if (calc <= 0x1) {
+                data ^= (uint32_t)byte << 24;
+                for (uint8_t bit=0; bit<8; bit++) { data = (data & 0x80000000) ? (data << 1) ^ 0x04C11DB7 : data << 1; }
+            } else if (calc <= 0x3) {
+                data ^= (uint32_t)byte << 8;
+                for (uint8_t bit=0; bit<8; bit++) { data = (data & 0x8000) ? ((data << 1) ^ 0x1021) & 0xFFFF : (data << 1) & 0xFFFF; }
+            } else if (calc == 0xE) {
+                data ^= (uint32_t)__builtin_parity(byte);
+            } else if (calc == 0xF) {
+                data += byte;
+            }
+        }
+        _dmaHw.sniff_data = data;
+    }
+    /** @private */
+    void __dmaFinish__(const uint channel, const uint64_t doneNs) {
+        __dmaChannel__ &dmaChannel = _dmaChannels[channel];
+        dmaChannel.started = true;
+        dmaChannel.doneNs = doneNs;
+        _dmaHw.ch[channel].transfer_count = 0;
+    }
+    /** @private */
+    void __dmaRun__() {
+        for (uint channel=0; channel<NUM_DMA_CHANNELS; channel++) {
+            __dmaChannel__ &tx = _dmaChannels[channel];
+            if (tx.busy == false or tx.started == true) { continue; }
+            const dma_channel_config &txConfig = tx.config;
+            const uint8_t size = (uint8_t)(1u << txConfig.size);
+            dma_channel_hw_t &txHw = _dmaHw.ch[channel];
+        // Memory to memory:
+            if (txConfig.dreq == DREQ_FORCE) {
+                for (uint32_t i=0; i<txHw.transfer_count; i++) {
+                    const uint32_t value = __dmaRead__(txHw.read_addr, size);
+                    __sniff__(channel, size, value);
+                    __dmaWrite__(txHw.write_addr, size, value);
+                    if (txConfig.readIncrement) {
+                        txHw.read_addr = txConfig.ringWrite ? txHw.read_addr + size
+                                            : __ringStep__(txHw.read_addr, size, txConfig.ringBits);
+                    }
+                    if (txConfig.writeIncrement) {
+                        txHw.write_addr = txConfig.ringWrite ? __ringStep__(txHw.write_addr, size, txConfig.ringBits)
+                                            : txHw.write_addr + size;
+                    }
+                }
+                __dmaFinish__(channel, _nowNs + txHw.transfer_count * 8);
+                continue;
+            }
+        // SPI transmit, paired with a triggered receive channel on the same port:
+            const int8_t port = __spiPortOfDreq__(txConfig.dreq, true);
+            if (port < 0) { continue; }
+            int rxChannel = -1;
+            for (uint i=0; i<NUM_DMA_CHANNELS; i++) {
+                const __dmaChannel__ &rx = _dmaChannels[i];
+                if (rx.busy == true and rx.started == false and __spiPortOfDreq__(rx.config.dreq, false) == port) {
+                    rxChannel = i;
+                    break;
+                }
+            }
+            const uint32_t frames = txHw.transfer_count;
+            for (uint32_t i=0; i<frames; i++) {
+                const uint16_t txFrame = (uint16_t)__dmaRead__(txHw.read_addr, size);
+                __sniff__(channel, size, txFrame);
+                const uint16_t rxFrame = __spiFrame__(port, txFrame);
+                if (txConfig.readIncrement) { txHw.read_addr = __ringStep__(txHw.read_addr, size,
+                                                                    txConfig.ringWrite ? 0 : txConfig.ringBits); }
+                if (rxChannel >= 0 and _dmaHw.ch[rxChannel].transfer_count > 0) {
+                    dma_channel_hw_t &rxHw = _dmaHw.ch[rxChannel];
+                    const dma_channel_config &rxConfig = _dmaChannels[rxChannel].config;
+                    const uint8_t rxSize = (uint8_t)(1u << rxConfig.size);
+                    __sniff__(rxChannel, rxSize, rxFrame);
+                    __dmaWrite__(rxHw.write_addr, rxSize, rxFrame);
+                    if (rxConfig.writeIncrement) { rxHw.write_addr = __ringStep__(rxHw.write_addr, rxSize,
+                                                                        rxConfig.ringWrite ? rxConfig.ringBits : 0); }
+                    rxHw.transfer_count--;
+                }
+            }
+            const uint64_t busyNs = __spiTimeNs__(port, frames);
+            _spiPorts[port].counters.calls++;
+            _spiPorts[port].counters.busyNs += busyNs;
+            __dmaFinish__(channel, _nowNs + busyNs);
+            if (rxChannel >= 0 and _dmaHw.ch[rxChannel].transfer_count == 0) {
+                __dmaFinish__(rxChannel, _nowNs + busyNs);
+            }
+        }
+    }
+    /** @private */
+    void __dispatch__(const uint irqNum) {
+        if ((_irqEnabled & (1u << irqNum)) == 0) { return; }
+        for (irq_handler_t handler : _irqHandlers[irqNum]) { handler(); }
+    }
+    /** @private */
+    void __service__() {
+    // Complete DMA transfers:
+        for (uint channel=0; channel<NUM_DMA_CHANNELS; channel++) {
+            __dmaChannel__ &dmaChannel = _dmaChannels[channel];
+            if (dmaChannel.busy == false or dmaChannel.started == false) { continue; }
+            if (_nowNs < dmaChannel.doneNs) { continue; }
+            dmaChannel.busy = false;
+            dmaChannel.started = false;
+            if (dmaChannel.config.irqQuiet == false and dmaChannel.irq0Enabled == true) {
+                _dmaHw.ints0 |= (1u << channel);
+            }
+        }
+        if (_irqsEnabled == false or _inIrq == true) { return; }
+        _inIrq = true;
+    // DMA interrupts:
+        if ((_dmaHw.ints0 & _dmaHw.inte0) != 0) { __dispatch__(DMA_IRQ_0); }
+    // GPIO interrupts:
+        if ((_irqEnabled & (1u << IO_IRQ_BANK0)) != 0) {
+            for (uint8_t pin=0; pin<_NUM_PINS; pin++) {
+                const uint32_t events = _gpioIrqStatus[pin] & _gpioIrqEnabled[pin];
+                if (events == 0) { continue; }
+                if (_gpioRawHandlers[pin] != nullptr) {
+                    _gpioRawHandlers[pin]();
+                } else if (_gpioCallback != nullptr) {
+                    _gpioIrqStatus[pin] = 0;
+                    _gpioCallback(pin, events);
+                } else {
+                    _gpioIrqStatus[pin] = 0;
+                }
+            }
+        }
+    // Repeating timers:
+        for (size_t i=0; i<_timers.size(); i++) {
+            if (_nowNs < _timers[i].dueNs) { continue; }
+            repeating_timer_t *timer = _timers[i].timer;
+            const bool again = timer->callback(timer);
+            if (i >= _timers.size() or _timers[i].timer != timer) { continue; }  // Cancelled in callback.
+            if (again == true) {
+                const uint64_t delayUs = (timer->delay_us < 0) ? -timer->delay_us : timer->delay_us;
+                _timers[i].dueNs += delayUs * 1000;
+            } else {
+                _timers.erase(_timers.begin() + i);
+                i--;
+            }
+        }
+        _inIrq = false;
+    }
+    /** @private */
+    void inline __poll__() {
+    // Step to the next DMA completion if one is due, otherwise by a poll step:
+        uint64_t nextNs = _nowNs + _POLL_STEP_NS;
+        for (uint channel=0; channel<NUM_DMA_CHANNELS; channel++) {
+            const __dmaChannel__ &dmaChannel = _dmaChannels[channel];
+            if (dmaChannel.busy == true and dmaChannel.started == true and dmaChannel.doneNs > _nowNs) {
+                nextNs = MIN(nextNs, dmaChannel.doneNs);
+            }
+        }
+        _nowNs = nextNs;
+        __service__();
+    }
+/*
+ * ############################ Public functions: ############################
+ */
+    /**
+     * @brief Reset the emulation.
+     * Sets the clock to 0, detaches all devices, and returns the GPIO, buses, DMA, spin locks,
+     * timers, ADC and PWM to their power on state.
+     */
+    void reset() {
+        _nowNs = 0;
+        _irqsEnabled = true;
+        _inIrq = false;
+        _coreNum = 0;
+        _gpioOut = 0;
+        _gpioDir = 0;
+        _gpioIn = 0;
+        _gpioDriven = 0;
+        _gpioPullUp = 0;
+        _gpioCallback = nullptr;
+        for (uint8_t pin=0; pin<_NUM_PINS; pin++) {
+            _gpioFunction[pin] = GPIO_FUNC_NULL;
+            _gpioIrqEnabled[pin] = 0;
+            _gpioIrqStatus[pin] = 0;
+            _gpioRawHandlers[pin] = nullptr;
+        }
+        _irqEnabled = 0;
+        for (uint8_t i=0; i<32; i++) { _irqHandlers[i].clear(); }
+        for (uint8_t i=0; i<2; i++) {
+            _spiPorts[i] = __spiPort__();
+            _i2cPorts[i] = __i2cPort__();
+        }
+        memset((void *)&_dmaHw, 0, sizeof(_dmaHw));
+        for (uint i=0; i<NUM_DMA_CHANNELS; i++) { _dmaChannels[i] = __dmaChannel__(); }
+        memset((void *)_spinLocks, 0, sizeof(_spinLocks));
+        _spinLocksClaimed = 0;
+        _timers.clear();
+        memset(_adcValues, 0, sizeof(_adcValues));
+        _adcInput = 0;
+        memset(_pwmWraps, 0xFF, sizeof(_pwmWraps));
+        memset(_pwmLevels, 0, sizeof(_pwmLevels));
+        memset(_pwmEnabled, 0, sizeof(_pwmEnabled));
+    }
+    /**
+     * @brief Get the virtual time.
+     * @return uint64_t Nanoseconds since reset.
+     */
+    uint64_t getTimeNs() {
+        return _nowNs;
+    }
+    /**
+     * @brief Advance the virtual clock.
+     * Completes DMA transfers, and delivers interrupts and timers that fall due.
+     * @param us Microseconds to advance.
+     */
+    void advanceUs(const uint64_t us) {
+        const uint64_t endNs = _nowNs + (us * 1000);
+        while (_nowNs < endNs) {
+            __poll__();
+            if (_nowNs > endNs) { _nowNs = endNs; }
+        }
+    }
+    /**
+     * @brief Set the core number returned by get_core_num().
+     * @param coreNum 0 or 1.
+     */
+    void setCoreNum(const uint8_t coreNum) {
+        _coreNum = coreNum & 1;
+    }
+    /**
+     * @brief Drive a pin from the host.
+     * The level is read by gpio_get() while the pin is an input, and edges raise GPIO interrupts.
+     * @param pin Pin to drive.
+     * @param level Level to drive.
+     */
+    void setInput(const uint8_t pin, const bool level) {
+        const uint32_t before = __padLevels__();
+        _gpioDriven |= (1u << pin);
+        if (level == true) { _gpioIn |= (1u << pin); } else { _gpioIn &= ~(1u << pin); }
+        __padsChanged__(before);
+    }
+    /**
+     * @brief Stop driving a pin from the host.
+     * @param pin Pin to release, it then reads its pull up.
+     */
+    void releaseInput(const uint8_t pin) {
+        const uint32_t before = __padLevels__();
+        _gpioDriven &= ~(1u << pin);
+        __padsChanged__(before);
+    }
+    /**
+     * @brief Get the level on a pin.
+     * @param pin Pin to read.
+     * @return true Pin is high.
+     * @return false Pin is low.
+     */
+    bool getLevel(const uint8_t pin) {
+        return (__padLevels__() >> pin) & 1u;
+    }
+    /**
+     * @brief Get the function of a pin.
+     * @param pin Pin to read.
+     * @return uint8_t One of the GPIO_FUNC_* values.
+     */
+    uint8_t getFunction(const uint8_t pin) {
+        return _gpioFunction[pin];
+    }
+    /**
+     * @brief Attach a SPI device model.
+     * The chip select pin is pulled high, as by an external resistor, until the driver drives it.
+     * @param spiPort Port the device is on.
+     * @param csPin Chip select pin, active low.
+     * @param device Device model, must outlive the emulation or reset().
+     */
+    void attachSpiDevice(spi_inst_t *spiPort, const uint8_t csPin, spiDevice *device);
+    /**
+     * @brief Attach an I2C device model.
+     * @param i2cPort Port the device is on.
+     * @param address 7 bit address.
+     * @param device Device model, must outlive the emulation or reset().
+     */
+    void attachI2cDevice(i2c_inst_t *i2cPort, const uint8_t address, i2cDevice *device);
+    /**
+     * @brief Get the counters of a SPI port.
+     * @param spiPort SPI port.
+     * @return busCounters_t Copy of the counters.
+     */
+    busCounters_t getSpiCounters(spi_inst_t *spiPort);
+    /**
+     * @brief Get the counters of an I2C port.
+     * @param i2cPort I2C port.
+     * @return busCounters_t Copy of the counters.
+     */
+    busCounters_t getI2cCounters(i2c_inst_t *i2cPort);
+    /**
+     * @brief Clear the counters of all ports.
+     */
+    void resetCounters() {
+        for (uint8_t i=0; i<2; i++) {
+            _spiPorts[i].counters = busCounters_t();
+            _i2cPorts[i].counters = busCounters_t();
+        }
+    }
+    /**
+     * @brief Send data to a port in slave mode.
+     * Clocks bytes in as a master would, into a triggered receive DMA channel on the port, while
+     * data from a triggered transmit DMA channel is clocked out. Chip select is driven by the host
+     * with setInput().
+     * @param spiPort SPI port, initialized as slave.
+     * @param src Data from the master.
+     * @param dst Buffer for data to the master, may be nullptr.
+     * @param len Length in bytes.
+     */
+    void slaveTransfer(spi_inst_t *spiPort, const uint8_t *src, uint8_t *dst, const size_t len);
+    /**
+     * @brief Set the reading of an ADC input.
+     * @param input Input, 0-3 for the pins, 4 for the temperature sensor.
+     * @param value 12 bit reading.
+     */
+    void setAdcValue(const uint8_t input, const uint16_t value) {
+        if (input < 5) { _adcValues[input] = value & 0x0FFF; }
+    }
+    /**
+     * @brief Get the level of a PWM channel.
+     * @param slice Slice number.
+     * @param channel Channel, 0 (A) or 1 (B).
+     * @return uint16_t Level.
+     */
+    uint16_t getPwmLevel(const uint8_t slice, const uint8_t channel) {
+        return _pwmLevels[slice & 7][channel & 1];
+    }
+    /**
+     * @brief Get the wrap of a PWM slice.
+     * @param slice Slice number.
+     * @return uint16_t Wrap.
+     */
+    uint16_t getPwmWrap(const uint8_t slice) {
+        return _pwmWraps[slice & 7];
+    }
+};
+
+/*
+ * ############################ SDK functions: ############################
+ */
+struct spi_inst { spi_hw_t hw; };
+#define spi0 ((spi_inst_t *)&myHostSim::_spiHw[0])
+#define spi1 ((spi_inst_t *)&myHostSim::_spiHw[1])
+/** @private */
+i2c_inst_t _myHostSimI2c[2] = { {0}, {1} };
+/** @private */
+pio_hw_t _myHostSimPio[2];
+#define pio0 (&_myHostSimPio[0])
+#define pio1 (&_myHostSimPio[1])
+#define i2c0 (&_myHostSimI2c[0])
+#define i2c1 (&_myHostSimI2c[1])
+#define dma_hw (&myHostSim::_dmaHw)
+
+// Platform:
+static inline void tight_loop_contents(void) { myHostSim::__poll__(); }
+static inline void __compiler_memory_barrier(void) {}
+static inline void __dmb(void) {}
+static inline void __sev(void) {}
+static inline void __wfe(void) { myHostSim::__poll__(); }
+static inline void __wfi(void) { myHostSim::__poll__(); }
+static inline void __breakpoint(void) { abort(); }
+static inline uint get_core_num(void) { return myHostSim::_coreNum; }
+static inline void panic(const char *message) { fprintf(stderr, "panic: %s\n", message); abort(); }
+
+// Timer:
+static inline uint64_t time_us_64(void) { myHostSim::__poll__(); return myHostSim::_nowNs / 1000; }
+static inline uint32_t time_us_32(void) { return (uint32_t)time_us_64(); }
+static inline void busy_wait_us(const uint64_t us) { myHostSim::advanceUs(us); }
+static inline void busy_wait_us_32(const uint32_t us) { myHostSim::advanceUs(us); }
+static inline void busy_wait_ms(const uint32_t ms) { myHostSim::advanceUs((uint64_t)ms * 1000); }
+static inline void sleep_us(const uint64_t us) { myHostSim::advanceUs(us); }
+static inline void sleep_ms(const uint32_t ms) { myHostSim::advanceUs((uint64_t)ms * 1000); }
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline uint64_t to_us_since_boot(const absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(const absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline absolute_time_t make_timeout_time_us(const uint64_t us) { return get_absolute_time() + us; }
+static inline absolute_time_t make_timeout_time_ms(const uint32_t ms) { return get_absolute_time() + (uint64_t)ms * 1000; }
+static inline absolute_time_t delayed_by_us(const absolute_time_t t, const uint64_t us) { return t + us; }
+static inline absolute_time_t delayed_by_ms(const absolute_time_t t, const uint32_t ms) { return t + (uint64_t)ms * 1000; }
+static inline int64_t absolute_time_diff_us(const absolute_time_t from, const absolute_time_t to) { return (int64_t)(to - from); }
+static inline bool time_reached(const absolute_time_t t) { return time_us_64() >= t; }
+static inline bool add_repeating_timer_us(const int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                                            repeating_timer_t *out) {
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    out->alarm_id = 1;
+    const uint64_t delayUs = (delay_us < 0) ? -delay_us : delay_us;
+    myHostSim::_timers.push_back({ out, myHostSim::_nowNs + delayUs * 1000 });
+    return true;
+}
+static inline bool add_repeating_timer_ms(const int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+                                            repeating_timer_t *out) {
+    return add_repeating_timer_us((int64_t)delay_ms * 1000, callback, user_data, out);
+}
+static inline bool cancel_repeating_timer(repeating_timer_t *timer) {
+    for (size_t i=0; i<myHostSim::_timers.size(); i++) {
+        if (myHostSim::_timers[i].timer == timer) {
+            myHostSim::_timers.erase(myHostSim::_timers.begin() + i);
+            timer->alarm_id = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sync:
+static inline uint32_t save_and_disable_interrupts(void) {
+    const uint32_t state = myHostSim::_irqsEnabled;
+    myHostSim::_irqsEnabled = false;
+    return state;
+}
+static inline void restore_interrupts(const uint32_t state) {
+    myHostSim::_irqsEnabled = (bool)state;
+    if (state != 0) { myHostSim::__service__(); }
+}
+static inline spin_lock_t *spin_lock_instance(const uint lock_num) { return &myHostSim::_spinLocks[lock_num]; }
+static inline uint spin_lock_get_num(spin_lock_t *lock) { return (uint)(lock - myHostSim::_spinLocks); }
+static inline spin_lock_t *spin_lock_init(const uint lock_num) {
+    myHostSim::_spinLocks[lock_num] = 0;
+    return &myHostSim::_spinLocks[lock_num];
+}
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock) {
+    const uint32_t state = save_and_disable_interrupts();
+    *lock = 1;                              // Single threaded, a held lock is never contended.
+    return state;
+}
+static inline void spin_unlock(spin_lock_t *lock, const uint32_t state) {
+    *lock = 0;
+    restore_interrupts(state);
+}
+static inline bool is_spin_locked(spin_lock_t *lock) { return *lock != 0; }
+static inline void spin_lock_claim(const uint lock_num) { myHostSim::_spinLocksClaimed |= (1u << lock_num); }
+static inline void spin_lock_unclaim(const uint lock_num) { myHostSim::_spinLocksClaimed &= ~(1u << lock_num); }
+static inline bool spin_lock_is_claimed(const uint lock_num) { return (myHostSim::_spinLocksClaimed >> lock_num) & 1u; }
+static inline int spin_lock_claim_unused(const bool required) {
+    for (uint i=0; i<NUM_SPIN_LOCKS; i++) {
+        if (spin_lock_is_claimed(i) == false) {
+            spin_lock_claim(i);
+            return (int)i;
+        }
+    }
+    if (required == true) { panic("No spin locks are available"); }
+    return -1;
+}
+
+// IRQ:
+static inline void irq_set_enabled(const uint num, const bool enabled) {
+    if (enabled == true) { myHostSim::_irqEnabled |= (1u << num); } else { myHostSim::_irqEnabled &= ~(1u << num); }
+}
+static inline bool irq_is_enabled(const uint num) { return (myHostSim::_irqEnabled >> num) & 1u; }
+static inline void irq_set_exclusive_handler(const uint num, irq_handler_t handler) {
+    myHostSim::_irqHandlers[num].clear();
+    myHostSim::_irqHandlers[num].push_back(handler);
+}
+static inline void irq_add_shared_handler(const uint num, irq_handler_t handler, const uint8_t order_priority) {
+    myHostSim::_irqHandlers[num].push_back(handler);
+}
+static inline void irq_remove_handler(const uint num, irq_handler_t handler) {
+    std::vector<irq_handler_t> &handlers = myHostSim::_irqHandlers[num];
+    for (size_t i=0; i<handlers.size(); i++) {
+        if (handlers[i] == handler) {
+            handlers.erase(handlers.begin() + i);
+            return;
+        }
+    }
+}
+
+// GPIO:
+static inline void gpio_set_function(const uint gpio, const enum gpio_function fn) { myHostSim::_gpioFunction[gpio] = fn; }
+static inline enum gpio_function gpio_get_function(const uint gpio) { return (enum gpio_function)myHostSim::_gpioFunction[gpio]; }
+static inline void gpio_set_dir(const uint gpio, const bool out) {
+    const uint32_t before = myHostSim::__padLevels__();
+    if (out == true) { myHostSim::_gpioDir |= (1u << gpio); } else { myHostSim::_gpioDir &= ~(1u << gpio); }
+    myHostSim::__padsChanged__(before);
+}
+static inline void gpio_set_dir_masked(const uint32_t mask, const uint32_t value) {
+    const uint32_t before = myHostSim::__padLevels__();
+    myHostSim::_gpioDir = (myHostSim::_gpioDir & ~mask) | (value & mask);
+    myHostSim::__padsChanged__(before);
+}
+static inline void gpio_set_dir_out_masked(const uint32_t mask) { gpio_set_dir_masked(mask, mask); }
+static inline void gpio_set_dir_in_masked(const uint32_t mask) { gpio_set_dir_masked(mask, 0); }
+static inline uint gpio_get_dir(const uint gpio) { return (myHostSim::_gpioDir >> gpio) & 1u; }
+static inline bool gpio_is_dir_out(const uint gpio) { return gpio_get_dir(gpio) == GPIO_OUT; }
+static inline void gpio_put_masked(const uint32_t mask, const uint32_t value) {
+    const uint32_t before = myHostSim::__padLevels__();
+    myHostSim::_gpioOut = (myHostSim::_gpioOut & ~mask) | (value & mask);
+    myHostSim::__padsChanged__(before);
+}
+static inline void gpio_put(const uint gpio, const bool value) { gpio_put_masked(1u << gpio, value ? (1u << gpio) : 0); }
+static inline void gpio_set_mask(const uint32_t mask) { gpio_put_masked(mask, mask); }
+static inline void gpio_clr_mask(const uint32_t mask) { gpio_put_masked(mask, 0); }
+static inline void gpio_xor_mask(const uint32_t mask) { gpio_put_masked(mask, ~myHostSim::_gpioOut); }
+static inline void gpio_put_all(const uint32_t value) { gpio_put_masked(0x3FFFFFFF, value); }
+static inline bool gpio_get(const uint gpio) { return (myHostSim::__padLevels__() >> gpio) & 1u; }
+static inline uint32_t gpio_get_all(void) { return myHostSim::__padLevels__(); }
+static inline void gpio_init(const uint gpio) {
+    gpio_set_dir(gpio, GPIO_IN);
+    gpio_put(gpio, false);
+    gpio_set_function(gpio, GPIO_FUNC_SIO);
+}
+static inline void gpio_init_mask(const uint32_t mask) {
+    for (uint gpio=0; gpio<myHostSim::_NUM_PINS; gpio++) {
+        if (mask & (1u << gpio)) { gpio_init(gpio); }
+    }
+}
+static inline void gpio_deinit(const uint gpio) { gpio_set_function(gpio, GPIO_FUNC_NULL); }
+static inline void gpio_set_pulls(const uint gpio, const bool up, const bool down) {
+    const uint32_t before = myHostSim::__padLevels__();
+    if (up == true) { myHostSim::_gpioPullUp |= (1u << gpio); } else { myHostSim::_gpioPullUp &= ~(1u << gpio); }
+    myHostSim::__padsChanged__(before);
+}
+static inline void gpio_pull_up(const uint gpio) { gpio_set_pulls(gpio, true, false); }
+static inline void gpio_pull_down(const uint gpio) { gpio_set_pulls(gpio, false, true); }
+static inline void gpio_disable_pulls(const uint gpio) { gpio_set_pulls(gpio, false, false); }
+static inline void gpio_set_input_enabled(const uint gpio, const bool enabled) {}
+static inline void gpio_set_irq_enabled(const uint gpio, const uint32_t events, const bool enabled) {
+    if (enabled == true) { myHostSim::_gpioIrqEnabled[gpio] |= events; } else { myHostSim::_gpioIrqEnabled[gpio] &= ~events; }
+}
+static inline void gpio_set_irq_enabled_with_callback(const uint gpio, const uint32_t events, const bool enabled,
+                                                        gpio_irq_callback_t callback) {
+    gpio_set_irq_enabled(gpio, events, enabled);
+    myHostSim::_gpioCallback = callback;
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
+static inline void gpio_set_irq_callback(gpio_irq_callback_t callback) { myHostSim::_gpioCallback = callback; }
+static inline uint32_t gpio_get_irq_event_mask(const uint gpio) {
+    return myHostSim::_gpioIrqStatus[gpio] & myHostSim::_gpioIrqEnabled[gpio];
+}
+static inline void gpio_acknowledge_irq(const uint gpio, const uint32_t events) { myHostSim::_gpioIrqStatus[gpio] &= ~events; }
+static inline void gpio_add_raw_irq_handler(const uint gpio, irq_handler_t handler) { myHostSim::_gpioRawHandlers[gpio] = handler; }
+static inline void gpio_add_raw_irq_handler_masked(const uint32_t mask, irq_handler_t handler) {
+    for (uint gpio=0; gpio<myHostSim::_NUM_PINS; gpio++) {
+        if (mask & (1u << gpio)) { gpio_add_raw_irq_handler(gpio, handler); }
+    }
+}
+static inline void gpio_remove_raw_irq_handler(const uint gpio, irq_handler_t handler) { myHostSim::_gpioRawHandlers[gpio] = nullptr; }
+
+// SPI:
+static inline uint spi_get_index(const spi_inst_t *spi) { return (spi == spi1) ? 1 : 0; }
+static inline spi_hw_t *spi_get_hw(spi_inst_t *spi) { return &spi->hw; }
+static inline const spi_hw_t *spi_get_const_hw(const spi_inst_t *spi) { return &spi->hw; }
+static inline uint spi_get_dreq(spi_inst_t *spi, const bool is_tx) {
+    return (spi_get_index(spi) == 0) ? (is_tx ? DREQ_SPI0_TX : DREQ_SPI0_RX) : (is_tx ? DREQ_SPI1_TX : DREQ_SPI1_RX);
+}
+static inline uint spi_set_baudrate(spi_inst_t *spi, const uint baudrate) {
+    myHostSim::_spiPorts[spi_get_index(spi)].baudRate = baudrate;
+    return baudrate;
+}
+static inline uint spi_get_baudrate(const spi_inst_t *spi) { return myHostSim::_spiPorts[spi_get_index(spi)].baudRate; }
+static inline uint spi_init(spi_inst_t *spi, const uint baudrate) {
+    myHostSim::_spiPorts[spi_get_index(spi)].dataBits = 8;
+    myHostSim::_spiPorts[spi_get_index(spi)].slave = false;
+    return spi_set_baudrate(spi, baudrate);
+}
+static inline void spi_deinit(spi_inst_t *spi) { myHostSim::_spiPorts[spi_get_index(spi)].baudRate = 0; }
+static inline void spi_set_format(spi_inst_t *spi, const uint data_bits, const spi_cpol_t cpol, const spi_cpha_t cpha,
+                                    const spi_order_t order) {
+    myHostSim::_spiPorts[spi_get_index(spi)].dataBits = (uint8_t)data_bits;
+}
+static inline void spi_set_slave(spi_inst_t *spi, const bool slave) { myHostSim::_spiPorts[spi_get_index(spi)].slave = slave; }
+static inline bool spi_is_writable(const spi_inst_t *spi) { return true; }
+static inline bool spi_is_readable(const spi_inst_t *spi) { return false; }
+static inline bool spi_is_busy(const spi_inst_t *spi) { return false; }
+/** @private */
+template <typename TX, typename RX>
+int __myHostSimSpiTransfer__(spi_inst_t *spi, const TX *src, const bool srcIncrement, RX *dst, const size_t len) {
+    const uint8_t port = spi_get_index(spi);
+    for (size_t i=0; i<len; i++) {
+        const uint16_t rxFrame = myHostSim::__spiFrame__(port, srcIncrement ? src[i] : src[0]);
+        if (dst != nullptr) { dst[i] = (RX)rxFrame; }
+    }
+    const uint64_t busyNs = myHostSim::__spiTimeNs__(port, len);
+    myHostSim::_spiPorts[port].counters.calls++;
+    myHostSim::_spiPorts[port].counters.busyNs += busyNs;
+    myHostSim::__advance__(busyNs);
+    return (int)len;
+}
+static inline int spi_write_read_blocking(spi_inst_t *spi, const uint8_t *src, uint8_t *dst, const size_t len) {
+    return __myHostSimSpiTransfer__(spi, src, true, dst, len);
+}
+static inline int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, const size_t len) {
+    return __myHostSimSpiTransfer__<uint8_t, uint8_t>(spi, src, true, nullptr, len);
+}
+static inline int spi_read_blocking(spi_inst_t *spi, const uint8_t repeated_tx_data, uint8_t *dst, const size_t len) {
+    return __myHostSimSpiTransfer__(spi, &repeated_tx_data, false, dst, len);
+}
+static inline int spi_write16_read16_blocking(spi_inst_t *spi, const uint16_t *src, uint16_t *dst, const size_t len) {
+    return __myHostSimSpiTransfer__(spi, src, true, dst, len);
+}
+static inline int spi_write16_blocking(spi_inst_t *spi, const uint16_t *src, const size_t len) {
+    return __myHostSimSpiTransfer__<uint16_t, uint16_t>(spi, src, true, nullptr, len);
+}
+static inline int spi_read16_blocking(spi_inst_t *spi, const uint16_t repeated_tx_data, uint16_t *dst, const size_t len) {
+    return __myHostSimSpiTransfer__(spi, &repeated_tx_data, false, dst, len);
+}
+
+// I2C:
+static inline uint i2c_hw_index(i2c_inst_t *i2c) { return i2c->index; }
+static inline uint i2c_set_baudrate(i2c_inst_t *i2c, const uint baudrate) {
+    myHostSim::_i2cPorts[i2c->index].baudRate = baudrate;
+    return baudrate;
+}
+static inline uint i2c_init(i2c_inst_t *i2c, const uint baudrate) { return i2c_set_baudrate(i2c, baudrate); }
+static inline void i2c_deinit(i2c_inst_t *i2c) { myHostSim::_i2cPorts[i2c->index].baudRate = 0; }
+static inline void i2c_set_slave_mode(i2c_inst_t *i2c, const bool slave, const uint8_t addr) {}
+/** @private */
+static inline int __myHostSimI2cTransfer__(i2c_inst_t *i2c, const uint8_t addr, const uint8_t *src, uint8_t *dst,
+                                            const size_t len, const bool nostop, const uint64_t timeoutUs) {
+    myHostSim::__i2cPort__ &i2cPort = myHostSim::_i2cPorts[i2c->index];
+    myHostSim::i2cDevice *device = nullptr;
+    for (auto &entry : i2cPort.devices) {
+        if (entry.first == addr) { device = entry.second; }
+    }
+    int result = PICO_ERROR_GENERIC;
+    if (device != nullptr) {
+        result = (src != nullptr) ? device->write(src, len, nostop) : device->read(dst, len, nostop);
+    }
+// Address byte, then the data bytes acknowledged, 9 clocks each:
+    const size_t bytes = (result > 0) ? (size_t)result : 0;
+    uint64_t busyNs = 0;
+    if (i2cPort.baudRate > 0) { busyNs = ((uint64_t)(bytes + 1) * 9 * 1000000000ull) / i2cPort.baudRate; }
+    if (timeoutUs > 0 and busyNs > timeoutUs * 1000) {
+        busyNs = timeoutUs * 1000;
+        result = PICO_ERROR_TIMEOUT;
+    }
+    i2cPort.counters.bytes += bytes;
+    i2cPort.counters.calls++;
+    i2cPort.counters.busyNs += busyNs;
+    if (nostop == false) { i2cPort.counters.transactions++; }
+    myHostSim::__advance__(busyNs);
+    return result;
+}
+static inline int i2c_write_blocking(i2c_inst_t *i2c, const uint8_t addr, const uint8_t *src, const size_t len, const bool nostop) {
+    return __myHostSimI2cTransfer__(i2c, addr, src, nullptr, len, nostop, 0);
+}
+static inline int i2c_read_blocking(i2c_inst_t *i2c, const uint8_t addr, uint8_t *dst, const size_t len, const bool nostop) {
+    return __myHostSimI2cTransfer__(i2c, addr, nullptr, dst, len, nostop, 0);
+}
+static inline int i2c_write_timeout_us(i2c_inst_t *i2c, const uint8_t addr, const uint8_t *src, const size_t len,
+                                        const bool nostop, const uint timeout_us) {
+    return __myHostSimI2cTransfer__(i2c, addr, src, nullptr, len, nostop, timeout_us);
+}
+static inline int i2c_read_timeout_us(i2c_inst_t *i2c, const uint8_t addr, uint8_t *dst, const size_t len,
+                                        const bool nostop, const uint timeout_us) {
+    return __myHostSimI2cTransfer__(i2c, addr, nullptr, dst, len, nostop, timeout_us);
+}
+
+// DMA:
+static inline void dma_channel_claim(const uint channel) { myHostSim::_dmaChannels[channel].claimed = true; }
+static inline void dma_channel_unclaim(const uint channel) { myHostSim::_dmaChannels[channel].claimed = false; }
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC32 0x0
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC32R 0x1
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC16 0x2
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC16R 0x3
+#define DMA_SNIFF_CTRL_CALC_VALUE_EVEN 0xe
+#define DMA_SNIFF_CTRL_CALC_VALUE_SUM 0xf
+static inline void dma_sniffer_enable(const uint channel, const uint mode, const bool force_channel_enable) {
+    if (force_channel_enable == true) { myHostSim::_dmaChannels[channel].config.sniff = true; }
+    dma_hw->sniff_ctrl = 0x01 | (channel << 1) | (mode << 5);
+}
+static inline void dma_sniffer_disable(void) { dma_hw->sniff_ctrl = 0; }
+static inline void dma_sniffer_set_data_accumulator(const uint32_t seed_value) { dma_hw->sniff_data = seed_value; }
+static inline uint32_t dma_sniffer_get_data_accumulator(void) { return dma_hw->sniff_data; }
+static inline bool dma_channel_is_claimed(const uint channel) { return myHostSim::_dmaChannels[channel].claimed; }
+static inline int dma_claim_unused_channel(const bool required) {
+    for (uint channel=0; channel<NUM_DMA_CHANNELS; channel++) {
+        if (myHostSim::_dmaChannels[channel].claimed == false) {
+            dma_channel_claim(channel);
+            return (int)channel;
+        }
+    }
+    if (required == true) { panic("No DMA channels are available"); }
+    return -1;
+}
+static inline dma_channel_config dma_channel_get_default_config(const uint channel) {
+    dma_channel_config config;
+    config.size = DMA_SIZE_32;
+    config.readIncrement = true;
+    config.writeIncrement = false;
+    config.dreq = DREQ_FORCE;
+    config.ringBits = 0;
+    config.ringWrite = false;
+    config.chainTo = channel;
+    config.irqQuiet = false;
+    config.enable = true;
+    config.sniff = false;
+    config.bswap = false;
+    return config;
+}
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, const enum dma_channel_transfer_size size) { c->size = size; }
+static inline void channel_config_set_read_increment(dma_channel_config *c, const bool incr) { c->readIncrement = incr; }
+static inline void channel_config_set_write_increment(dma_channel_config *c, const bool incr) { c->writeIncrement = incr; }
+static inline void channel_config_set_dreq(dma_channel_config *c, const uint dreq) { c->dreq = dreq; }
+static inline void channel_config_set_chain_to(dma_channel_config *c, const uint chain_to) { c->chainTo = chain_to; }
+static inline void channel_config_set_ring(dma_channel_config *c, const bool write, const uint size_bits) {
+    c->ringWrite = write;
+    c->ringBits = (uint8_t)size_bits;
+}
+static inline void channel_config_set_bswap(dma_channel_config *c, const bool bswap) { c->bswap = bswap; }
+static inline void channel_config_set_irq_quiet(dma_channel_config *c, const bool irq_quiet) { c->irqQuiet = irq_quiet; }
+static inline void channel_config_set_enable(dma_channel_config *c, const bool enable) { c->enable = enable; }
+static inline void channel_config_set_sniff_enable(dma_channel_config *c, const bool sniff_enable) { c->sniff = sniff_enable; }
+static inline void dma_channel_set_config(const uint channel, const dma_channel_config *config, const bool trigger);
+static inline void dma_channel_start(const uint channel) {
+    myHostSim::_dmaChannels[channel].busy = true;
+    myHostSim::_dmaChannels[channel].started = false;
+    myHostSim::__dmaRun__();
+}
+static inline void dma_start_channel_mask(const uint32_t chan_mask) {
+    for (uint channel=0; channel<NUM_DMA_CHANNELS; channel++) {
+        if (chan_mask & (1u << channel)) {
+            myHostSim::_dmaChannels[channel].busy = true;
+            myHostSim::_dmaChannels[channel].started = false;
+        }
+    }
+    myHostSim::__dmaRun__();
+}
+static inline void dma_channel_set_config(const uint channel, const dma_channel_config *config, const bool trigger) {
+    myHostSim::_dmaChannels[channel].config = *config;
+    if (trigger == true) { dma_channel_start(channel); }
+}
+static inline void dma_channel_set_read_addr(const uint channel, const volatile void *read_addr, const bool trigger) {
+    dma_hw->ch[channel].read_addr = (uintptr_t)read_addr;
+    if (trigger == true) { dma_channel_start(channel); }
+}
+static inline void dma_channel_set_write_addr(const uint channel, volatile void *write_addr, const bool trigger) {
+    dma_hw->ch[channel].write_addr = (uintptr_t)write_addr;
+    if (trigger == true) { dma_channel_start(channel); }
+}
+static inline void dma_channel_set_trans_count(const uint channel, const uint32_t trans_count, const bool trigger) {
+    dma_hw->ch[channel].transfer_count = trans_count;
+    if (trigger == true) { dma_channel_start(channel); }
+}
+static inline void dma_channel_configure(const uint channel, const dma_channel_config *config, volatile void *write_addr,
+                                            const volatile void *read_addr, const uint transfer_count, const bool trigger) {
+    dma_channel_set_read_addr(channel, read_addr, false);
+    dma_channel_set_write_addr(channel, write_addr, false);
+    dma_channel_set_trans_count(channel, transfer_count, false);
+    dma_channel_set_config(channel, config, trigger);
+}
+static inline bool dma_channel_is_busy(const uint channel) {
+    myHostSim::__poll__();
+    return myHostSim::_dmaChannels[channel].busy;
+}
+static inline void dma_channel_wait_for_finish_blocking(const uint channel) {
+    myHostSim::__dmaChannel__ &dmaChannel = myHostSim::_dmaChannels[channel];
+    if (dmaChannel.busy == true and dmaChannel.started == false) {
+        panic("DMA channel waited on has nothing to pace it");
+    }
+    while (dmaChannel.busy == true) { myHostSim::__poll__(); }
+}
+static inline void dma_channel_abort(const uint channel) {
+    myHostSim::_dmaChannels[channel].busy = false;
+    myHostSim::_dmaChannels[channel].started = false;
+}
+static inline void dma_channel_set_irq0_enabled(const uint channel, const bool enabled) {
+    myHostSim::_dmaChannels[channel].irq0Enabled = enabled;
+    if (enabled == true) { dma_hw->inte0 |= (1u << channel); } else { dma_hw->inte0 &= ~(1u << channel); }
+}
+static inline bool dma_channel_get_irq0_status(const uint channel) { return (dma_hw->ints0 >> channel) & 1u; }
+static inline void dma_channel_acknowledge_irq0(const uint channel) { dma_hw->ints0 &= ~(1u << channel); }
+
+// Clocks:
+static inline uint32_t clock_get_hz(const enum clock_index clk_index) { return 125000000; }
+
+// PIO, not emulated, programs never fit so drivers take their fallback:
+static inline bool pio_can_add_program(PIO pio, const pio_program_t *program) { return false; }
+static inline uint pio_add_program(PIO pio, const pio_program_t *program) { panic("PIO is not emulated"); return 0; }
+static inline void pio_remove_program(PIO pio, const pio_program_t *program, const uint loaded_offset) {}
+static inline int pio_claim_unused_sm(PIO pio, const bool required) {
+    if (required == true) { panic("PIO is not emulated"); }
+    return -1;
+}
+static inline void pio_sm_unclaim(PIO pio, const uint sm) {}
+static inline void pio_gpio_init(PIO pio, const uint pin) { gpio_set_function(pin, (pio == pio0) ? GPIO_FUNC_PIO0 : GPIO_FUNC_PIO1); }
+static inline uint pio_get_dreq(PIO pio, const uint sm, const bool is_tx) { return ((pio == pio0) ? 0 : 8) + (is_tx ? 0 : 4) + sm; }
+static inline void pio_sm_set_consecutive_pindirs(PIO pio, const uint sm, const uint pin_base, const uint pin_count, const bool is_out) {}
+static inline void pio_sm_set_pins_with_mask(PIO pio, const uint sm, const uint32_t pin_values, const uint32_t pin_mask) {}
+static inline void pio_sm_init(PIO pio, const uint sm, const uint initial_pc, const pio_sm_config *config) {}
+static inline void pio_sm_set_enabled(PIO pio, const uint sm, const bool enabled) {}
+static inline void pio_sm_put_blocking(PIO pio, const uint sm, const uint32_t data) { panic("PIO is not emulated"); }
+static inline uint32_t pio_sm_get_blocking(PIO pio, const uint sm) { panic("PIO is not emulated"); return 0; }
+static inline bool pio_sm_is_tx_fifo_empty(PIO pio, const uint sm) { return true; }
+static inline void sm_config_set_out_pins(pio_sm_config *c, const uint out_base, const uint out_count) {}
+static inline void sm_config_set_set_pins(pio_sm_config *c, const uint set_base, const uint set_count) {}
+static inline void sm_config_set_in_pins(pio_sm_config *c, const uint in_base) {}
+static inline void sm_config_set_sideset_pins(pio_sm_config *c, const uint sideset_base) {}
+static inline void sm_config_set_out_shift(pio_sm_config *c, const bool shift_right, const bool autopull, const uint pull_threshold) {}
+static inline void sm_config_set_in_shift(pio_sm_config *c, const bool shift_right, const bool autopush, const uint push_threshold) {}
+static inline void sm_config_set_clkdiv(pio_sm_config *c, const float div) {}
+static inline void sm_config_set_clkdiv_int_frac(pio_sm_config *c, const uint16_t div_int, const uint8_t div_frac) {}
+static inline pio_sm_config pio_get_default_sm_config(void) { return pio_sm_config(); }
+
+// ADC:
+static inline void adc_init(void) {}
+static inline void adc_gpio_init(const uint gpio) {
+    gpio_set_function(gpio, GPIO_FUNC_NULL);
+    gpio_disable_pulls(gpio);
+}
+static inline void adc_select_input(const uint input) { myHostSim::_adcInput = (uint8_t)input; }
+static inline uint adc_get_selected_input(void) { return myHostSim::_adcInput; }
+static inline void adc_set_temp_sensor_enabled(const bool enable) {}
+static inline uint16_t adc_read(void) {
+    myHostSim::__advance__(2000);                                 // 96 ADC clocks at 48MHz.
+    return myHostSim::_adcValues[myHostSim::_adcInput];
+}
+
+// PWM:
+static inline uint pwm_gpio_to_slice_num(const uint gpio) { return (gpio >> 1u) & 7u; }
+static inline uint pwm_gpio_to_channel(const uint gpio) { return gpio & 1u; }
+static inline void pwm_set_wrap(const uint slice_num, const uint16_t wrap) { myHostSim::_pwmWraps[slice_num] = wrap; }
+static inline void pwm_set_chan_level(const uint slice_num, const uint chan, const uint16_t level) {
+    myHostSim::_pwmLevels[slice_num][chan] = level;
+}
+static inline void pwm_set_gpio_level(const uint gpio, const uint16_t level) {
+    pwm_set_chan_level(pwm_gpio_to_slice_num(gpio), pwm_gpio_to_channel(gpio), level);
+}
+static inline void pwm_set_clkdiv_int_frac(const uint slice_num, const uint8_t integer, const uint8_t fract) {}
+static inline void pwm_set_clkdiv(const uint slice_num, const float divider) {}
+static inline void pwm_set_phase_correct(const uint slice_num, const bool phase_correct) {}
+static inline void pwm_set_enabled(const uint slice_num, const bool enabled) { myHostSim::_pwmEnabled[slice_num] = enabled; }
+
+/*
+ * ############################ Public functions, SDK dependant: ############################
+ */
+void myHostSim::attachSpiDevice(spi_inst_t *spiPort, const uint8_t csPin, spiDevice *device) {
+    _spiPorts[spi_get_index(spiPort)].devices.push_back({ csPin, device, 0 });
+    setInput(csPin, true);
+}
+
+void myHostSim::attachI2cDevice(i2c_inst_t *i2cPort, const uint8_t address, i2cDevice *device) {
+    _i2cPorts[i2c_hw_index(i2cPort)].devices.push_back({ address, device });
+}
+
+myHostSim::busCounters_t myHostSim::getSpiCounters(spi_inst_t *spiPort) {
+    return _spiPorts[spi_get_index(spiPort)].counters;
+}
+
+myHostSim::busCounters_t myHostSim::getI2cCounters(i2c_inst_t *i2cPort) {
+    return _i2cPorts[i2c_hw_index(i2cPort)].counters;
+}
+
+void myHostSim::slaveTransfer(spi_inst_t *spiPort, const uint8_t *src, uint8_t *dst, const size_t len) {
+    const int8_t port = (int8_t)spi_get_index(spiPort);
+    int txChannel = -1;
+    int rxChannel = -1;
+    for (uint channel=0; channel<NUM_DMA_CHANNELS; channel++) {
+        const __dmaChannel__ &dmaChannel = _dmaChannels[channel];
+        if (dmaChannel.busy == false) { continue; }
+        if (__spiPortOfDreq__(dmaChannel.config.dreq, true) == port) { txChannel = channel; }
+        if (__spiPortOfDreq__(dmaChannel.config.dreq, false) == port) { rxChannel = channel; }
+    }
+    for (size_t i=0; i<len; i++) {
+        uint8_t miso = 0x00;
+        if (txChannel >= 0 and _dmaHw.ch[txChannel].transfer_count > 0) {
+            dma_channel_hw_t &txHw = _dmaHw.ch[txChannel];
+            miso = *(volatile uint8_t *)txHw.read_addr;
+            if (_dmaChannels[txChannel].config.readIncrement) { txHw.read_addr++; }
+            if (--txHw.transfer_count == 0) { __dmaFinish__(txChannel, _nowNs); }
+        }
+        if (dst != nullptr) { dst[i] = miso; }
+        if (rxChannel >= 0 and _dmaHw.ch[rxChannel].transfer_count > 0) {
+            dma_channel_hw_t &rxHw = _dmaHw.ch[rxChannel];
+            const dma_channel_config &rxConfig = _dmaChannels[rxChannel].config;
+            *(volatile uint8_t *)rxHw.write_addr = src[i];
+            if (rxConfig.writeIncrement) {
+                rxHw.write_addr = __ringStep__(rxHw.write_addr, 1, rxConfig.ringWrite ? rxConfig.ringBits : 0);
+            }
+            if (--rxHw.transfer_count == 0) { __dmaFinish__(rxChannel, _nowNs); }
+        }
+    }
+    const uint64_t busyNs = __spiTimeNs__(port, len);
+    _spiPorts[port].counters.bytes += len;
+    _spiPorts[port].counters.calls++;
+    _spiPorts[port].counters.busyNs += busyNs;
+    __advance__(busyNs);
+}
+#endif
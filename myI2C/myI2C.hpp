@@ -13,6 +13,9 @@
 
 #include <hardware/gpio.h>
 #include <hardware/i2c.h>
+#include <hardware/sync.h>
+#include <hardware/timer.h>
+#include <pico/error.h>
 
 #include "../myStandardDefines.hpp"
 #include "../myErrorCodes.hpp"
@@ -53,13 +56,13 @@ namespace myI2C {
     static const int16_t ERROR_NOT_INITIALIZED = MY_ERROR_MYI2C_NOT_INITIALIZED;
 // Pin Mappings:
     /** @private */
-    static const uint8_t _sdaPins[MY_I2C_NUM_PORTS][MY_I2C_NUM_PINS] =
+    static constexpr uint8_t _sdaPins[MY_I2C_NUM_PORTS][MY_I2C_NUM_PINS] =
         {
             { 0, 4,  8, 12, 16, 20, 24, 28 },
             { 2, 6, 10, 14, 18, MY_NOT_A_PIN, MY_NOT_A_PIN, MY_NOT_A_PIN},
         };
     /** @private */
-    static const uint8_t _sclPins[MY_I2C_NUM_PORTS][MY_I2C_NUM_PINS] =
+    static constexpr uint8_t _sclPins[MY_I2C_NUM_PORTS][MY_I2C_NUM_PINS] =
         {
             { 1, 5,  9, 13, 17, 21, 25, 29 },
             { 3, 7, 11, 15, 19, MY_NOT_A_PIN, MY_NOT_A_PIN, MY_NOT_A_PIN },
@@ -69,15 +72,47 @@ namespace myI2C {
     static const uint8_t _PIN_SDA = 0;
     /** @private */
     static const uint8_t _PIN_SCL = 1;
+/*
+ * ########################### Types: #################################
+ */
+#ifdef MY_I2C_STATS
+    /**
+     * @brief Transfer counters.
+     * Per port counters, kept when MY_I2C_STATS is defined before including. Returned by getStats(),
+     * cleared by resetStats().
+     */
+    struct stats_t {
+        uint64_t bytes = 0;                 // Bytes transfered.
+        uint32_t transactions = 0;          // Transfer calls.
+        uint64_t busyUs = 0;                // Time spent blocked in transfer calls.
+        uint32_t maxLatencyUs = 0;          // Longest single transfer call.
+        uint32_t timeouts = 0;              // Transfers that timed out.
+        uint32_t nacks = 0;                 // Transfers not acknowledged.
+    };
+#endif
 /*
  * ########################### Variables: #################################
  */
     /** @private */
     uint8_t _status = 0b00001100; // State of the i2c ports
     uint8_t _pins[MY_I2C_NUM_PORTS][2] = { {MY_NOT_A_PIN, MY_NOT_A_PIN}, {MY_NOT_A_PIN, MY_NOT_A_PIN} };
+#ifdef MY_I2C_STATS
+    /** @private */
+    stats_t _stats[MY_I2C_NUM_PORTS];
+#endif
 /*
  * #################### Validation Functions: #############################
  */
+    /** @private */
+    constexpr bool __isPortPin__(const uint8_t (&pins)[MY_I2C_NUM_PORTS][MY_I2C_NUM_PINS],
+                                    const uint8_t i2cIndex, const uint8_t pin) {
+        if (myHelpers::isPin(pin) == false) { return false; }
+        if (i2cIndex >= MY_I2C_NUM_PORTS) { return false; }
+        for (uint8_t i=0; i<MY_I2C_NUM_PINS; i++) {
+            if (pin == pins[i2cIndex][i]) { return true; }
+        }
+        return false;
+    }
 
     /**
      * @brief Validate an I2C address.
@@ -103,12 +138,7 @@ namespace myI2C {
      * @return false Pin is not valid SDA pin, or not a valid pin.
      */
     bool isSdaPin(i2c_inst_t *i2cPort, const uint8_t pin) {
-        if (myHelpers::isPin(pin) == false) { return false; }
-        const uint8_t i2cIndex = i2c_hw_index(i2cPort);
-        for (uint8_t i=0; i<MY_I2C_NUM_PINS; i++) {
-            if (pin == _sdaPins[i2cIndex][i]) { return true; }
-        }
-        return false;
+        return __isPortPin__(_sdaPins, i2c_hw_index(i2cPort), pin);
     }
     /**
      * @brief Validate SCL pin.
@@ -120,13 +150,29 @@ namespace myI2C {
      * @return false Pin is not a valid SCL pin, or not a valid pin.
      */
     bool isSclPin(i2c_inst_t *i2cPort, const uint8_t pin) {
-        if (myHelpers::isPin(pin) == false) { return false; }
-        const uint8_t i2cIndex = i2c_hw_index(i2cPort);
-        for (uint8_t i=0; i<MY_I2C_NUM_PINS; i++) {
-            if (pin == _sclPins[i2cIndex][i]) { return true; }
-        }
-        return false;
+        return __isPortPin__(_sclPins, i2c_hw_index(i2cPort), pin);
     }
+/*
+ * ######################## Pin configurations: ##############################
+ */
+    /**
+     * @brief Pin configuration, validated at compile time.
+     * An invalid pin for the port fails to compile. Pass to initializeMaster<>() or
+     * initializeSlave<>(), which then skip the runtime pin checks.
+     * IE: myI2C::initializeMaster<myI2C::pins_t<0, 4, 5>>(400000);
+     * @tparam I2C_INDEX I2C port number, 0 or 1.
+     * @tparam SDA_PIN SDA pin.
+     * @tparam SCL_PIN SCL pin.
+     */
+    template <uint8_t I2C_INDEX, uint8_t SDA_PIN, uint8_t SCL_PIN>
+    struct pins_t {
+        static_assert(I2C_INDEX < MY_I2C_NUM_PORTS, "Invalid I2C port.");
+        static_assert(__isPortPin__(_sdaPins, I2C_INDEX, SDA_PIN), "Invalid SDA pin for I2C port.");
+        static_assert(__isPortPin__(_sclPins, I2C_INDEX, SCL_PIN), "Invalid SCL pin for I2C port.");
+        static constexpr uint8_t i2cIndex = I2C_INDEX;
+        static constexpr uint8_t sdaPin = SDA_PIN;
+        static constexpr uint8_t sclPin = SCL_PIN;
+    };
 /*
  * ######################## Public status functions: ##############################
  */
@@ -201,6 +247,19 @@ namespace myI2C {
         _pins[i2cIndex][_PIN_SDA] = sdaPin;
         _pins[i2cIndex][_PIN_SCL] = sclPin;
     }
+    /** @private */
+    int32_t __initialize__(i2c_inst_t *i2cPort, const uint8_t sdaPin, const uint8_t sclPin,
+                            const uint32_t baud, const bool master, const uint8_t address) {
+        int32_t acheivedRate = i2c_init(i2cPort, baud);
+        gpio_set_function(sdaPin, GPIO_FUNC_I2C);
+        gpio_set_function(sclPin, GPIO_FUNC_I2C);
+        gpio_pull_up(sdaPin);
+        gpio_pull_up(sclPin);
+        __setPins__(i2cPort, sdaPin, sclPin);
+        __setMaster__(i2cPort, master, address);
+        __setInit__(i2cPort, true);
+        return acheivedRate;
+    }
 /*
  * ########################### Initialize Functions: #################################
  */
@@ -219,14 +278,20 @@ namespace myI2C {
         if (getInitialized(i2cPort) == true) { return ERROR_INITIALIZED; }
         if (isSdaPin(i2cPort, sdaPin) == false) { return ERROR_INVALID_SDA_PIN; }
         if (isSclPin(i2cPort, sclPin) == false) { return ERROR_INVALID_SCL_PIN; }
-        int32_t acheivedRate = i2c_init(i2cPort, baud);
-        gpio_set_function(sdaPin, GPIO_FUNC_I2C);
-        gpio_set_function(sclPin, GPIO_FUNC_I2C);
-        gpio_pull_up(sdaPin);
-        gpio_pull_up(sclPin);
-        __setPins__(i2cPort, sdaPin, sclPin);
-        __setMaster__(i2cPort, true);
-        return acheivedRate;
+        return __initialize__(i2cPort, sdaPin, sclPin, baud, true, 0x00);
+    }
+    /**
+     * @brief Initialize I2C in master mode, with pins validated at compile time.
+     * Only checks that the port isn't already initialized.
+     * @tparam PINS pins_t pin configuration.
+     * @param baud Requested baud in Hz.
+     * @return int32_t Positive Achieved baud rate in Hz, negative for error code.
+     */
+    template <class PINS>
+    int32_t initializeMaster(const uint32_t baud) {
+        i2c_inst_t *i2cPort = (PINS::i2cIndex == 0) ? i2c0 : i2c1;
+        if (getInitialized(i2cPort) == true) { return ERROR_INITIALIZED; }
+        return __initialize__(i2cPort, PINS::sdaPin, PINS::sclPin, baud, true, 0x00);
     }
     /**
      * @brief Initialize I2C in slave mode.
@@ -244,14 +309,21 @@ namespace myI2C {
         if (getInitialized(i2cPort) == true) { return ERROR_INITIALIZED; }
         if (isSdaPin(i2cPort, sdaPin) == false) { return ERROR_INVALID_SDA_PIN; }
         if (isSclPin(i2cPort, sclPin) == false) { return ERROR_INVALID_SCL_PIN; }
-        int32_t acheivedRate = i2c_init(i2cPort, baud);
-        gpio_set_function(sdaPin, GPIO_FUNC_I2C);
-        gpio_set_function(sclPin, GPIO_FUNC_I2C);
-        gpio_pull_up(sdaPin);
-        gpio_pull_up(sclPin);
-        __setPins__(i2cPort, sdaPin, sclPin);
-        __setMaster__(i2cPort, false, address);
-        return acheivedRate;
+        return __initialize__(i2cPort, sdaPin, sclPin, baud, false, address);
+    }
+    /**
+     * @brief Initialize I2C in slave mode, with pins validated at compile time.
+     * Only checks that the port isn't already initialized.
+     * @tparam PINS pins_t pin configuration.
+     * @param baud Requested baud rate.
+     * @param address I2C address to respond to.
+     * @return int32_t Postive is the achieved baud rate, negative for an error code.
+     */
+    template <class PINS>
+    int32_t initializeSlave(const uint32_t baud, const uint8_t address) {
+        i2c_inst_t *i2cPort = (PINS::i2cIndex == 0) ? i2c0 : i2c1;
+        if (getInitialized(i2cPort) == true) { return ERROR_INITIALIZED; }
+        return __initialize__(i2cPort, PINS::sdaPin, PINS::sclPin, baud, false, address);
     }
     /**
      * @brief Deinitialize an I2C port.
@@ -261,7 +333,7 @@ namespace myI2C {
      * @return int32_t Returns 0 (NO_ERROR) if deinitialized okay, negative for error code.
      */
     int32_t deinitialize(i2c_inst_t *i2cPort) {
-        if (getInitialized(i2cPort) == true) { return ERROR_NOT_INITIALIZED; }
+        if (getInitialized(i2cPort) == false) { return ERROR_NOT_INITIALIZED; }
         uint8_t i2cIndex = i2c_hw_index(i2cPort);
         i2c_deinit(i2cPort);
         __setInit__(i2cPort, false);
@@ -272,7 +344,94 @@ namespace myI2C {
         __setPins__(i2cPort, MY_NOT_A_PIN, MY_NOT_A_PIN);
         return NO_ERROR;
     }
-
-
+#ifdef MY_I2C_STATS
+/*
+ * ######################### Stats functions: ##############################
+ */
+    /**
+     * @brief Get the transfer counters of a port.
+     * Only available when MY_I2C_STATS is defined before including.
+     * @param i2cPort I2C port instance.
+     * @return stats_t Snapshot of the counters.
+     */
+    stats_t getStats(i2c_inst_t *i2cPort) {
+        const uint32_t irqState = save_and_disable_interrupts();
+        const stats_t stats = _stats[i2c_hw_index(i2cPort)];
+        restore_interrupts(irqState);
+        return stats;
+    }
+    /**
+     * @brief Clear the transfer counters of a port.
+     * Only available when MY_I2C_STATS is defined before including.
+     * @param i2cPort I2C port instance.
+     */
+    void resetStats(i2c_inst_t *i2cPort) {
+        const uint32_t irqState = save_and_disable_interrupts();
+        _stats[i2c_hw_index(i2cPort)] = stats_t();
+        restore_interrupts(irqState);
+    }
+    /** @private */
+    void __recordTransfer__(i2c_inst_t *i2cPort, const uint64_t startTime, const int result) {
+        const uint32_t elapsed = (uint32_t)(time_us_64() - startTime);
+        stats_t &stats = _stats[i2c_hw_index(i2cPort)];
+        stats.transactions++;
+        stats.busyUs += elapsed;
+        if (elapsed > stats.maxLatencyUs) { stats.maxLatencyUs = elapsed; }
+        if (result >= 0) {
+            stats.bytes += result;
+        } else if (result == PICO_ERROR_TIMEOUT) {
+            stats.timeouts++;
+        } else {
+            stats.nacks++;                  // PICO_ERROR_GENERIC, address or data not acknowledged.
+        }
+    }
+#endif
+/*
+ * ######################### Transfer functions: ##############################
+ */
+    /**
+     * @brief Write with timeout.
+     * i2c_write_timeout_us, counted when MY_I2C_STATS is defined.
+     * @param i2cPort I2C port instance.
+     * @param address Address of device.
+     * @param src Data to send.
+     * @param len Length of data in bytes.
+     * @param nostop True to keep the bus, and not send a stop.
+     * @param timeoutUs Timeout in microseconds.
+     * @return int Bytes written, or PICO_ERROR_GENERIC / PICO_ERROR_TIMEOUT.
+     */
+    int write_timeout_us(i2c_inst_t *i2cPort, const uint8_t address, const uint8_t *src, const size_t len,
+                            const bool nostop, const uint timeoutUs) {
+    #ifdef MY_I2C_STATS
+        const uint64_t startTime = time_us_64();
+        const int returnValue = i2c_write_timeout_us(i2cPort, address, src, len, nostop, timeoutUs);
+        __recordTransfer__(i2cPort, startTime, returnValue);
+        return returnValue;
+    #else
+        return i2c_write_timeout_us(i2cPort, address, src, len, nostop, timeoutUs);
+    #endif
+    }
+    /**
+     * @brief Read with timeout.
+     * i2c_read_timeout_us, counted when MY_I2C_STATS is defined.
+     * @param i2cPort I2C port instance.
+     * @param address Address of device.
+     * @param dst Buffer for read data.
+     * @param len Length of buffer in bytes.
+     * @param nostop True to keep the bus, and not send a stop.
+     * @param timeoutUs Timeout in microseconds.
+     * @return int Bytes read, or PICO_ERROR_GENERIC / PICO_ERROR_TIMEOUT.
+     */
+    int read_timeout_us(i2c_inst_t *i2cPort, const uint8_t address, uint8_t *dst, const size_t len,
+                            const bool nostop, const uint timeoutUs) {
+    #ifdef MY_I2C_STATS
+        const uint64_t startTime = time_us_64();
+        const int returnValue = i2c_read_timeout_us(i2cPort, address, dst, len, nostop, timeoutUs);
+        __recordTransfer__(i2cPort, startTime, returnValue);
+        return returnValue;
+    #else
+        return i2c_read_timeout_us(i2cPort, address, dst, len, nostop, timeoutUs);
+    #endif
+    }
 };
 #endif
\ No newline at end of file
@@ -194,7 +194,7 @@ class myMAX1415 {
          * okay, otherwise if an invalid SPI pin was passed during construction an error code is returned.
          * if an invalid reset pin, or data ready pin is passed, hardware reset, and hardware polling is
          * disabled respectivly.
-         * @param initSPI True = Initialize SPI bus, False = Don't initialize SPI bus.
+         * @param initSPI True = Initialize SPI bus, False = Don't initialize SPI bus. Skipped if the port is already initialized.
          * @param intClock True (default) = Enable internal clock. False = External clock.
          * @param clkFreq True (default) = Frequency of 2.4576MHz, False = Frequency of 1MHz
          * @param updateFreq The update frequency, one of the FREQ_* values. Defaults to 0x01, (FREQ_25/
@@ -245,6 +245,8 @@ class myMAX1415 {
         const uint8_t _drdyPin = MY_NOT_A_PIN;
 /* ############# Private Variables: ################# */
         spi_inst_t *_spiPort;
+        int16_t     _profileId = -1;    // 8 bit frames, for registers.
+        int16_t     _profileId16 = -1;  // 16 bit frames, for the data register.
         bool        _haveReset = false;
         bool        _haveDrdy = false;
         uint8_t     _commsRegData = 0x00;
@@ -469,10 +471,22 @@ int16_t myMAX1415::initialize(const bool initSPI, const bool intClock, const boo
                                     const uint8_t updateFreq, const bool clkDiv) {
     int32_t returnValue;
 // Init SPI:
-    if (initSPI == true) {
+    if (initSPI == true and mySPI::getPortInit(_spiPort) == false) {
         returnValue = mySPI::initializeMaster(_spiPort, _sckPin, _misoPin, _mosiPin, 5000*1000); // 5Mhz.
         if (returnValue < 0) { return (int16_t)returnValue; }
     }
+// Register profiles once, the data register is read as a single 16 bit frame:
+    if (_profileId < 0) {
+        mySPI::profile_t profile;
+        profile.baudRate = 5000*1000;
+        returnValue = mySPI::registerProfile(_spiPort, profile);
+        if (returnValue < 0) { return (int16_t)returnValue; }
+        _profileId = returnValue;
+        profile.dataBits = 16;
+        returnValue = mySPI::registerProfile(_spiPort, profile);
+        if (returnValue < 0) { return (int16_t)returnValue; }
+        _profileId16 = returnValue;
+    }
 // Init CS Pin.
     if (myHelpers::isPin(_csPin) == false) { return ERROR_INVALID_CS_PIN; }
     gpio_init(_csPin);
@@ -598,38 +612,39 @@ uint8_t myMAX1415::__buildClockRegData__() {
 
 void myMAX1415::__writeReg__(const uint8_t reg, const uint8_t value) {
     uint8_t commsRegData = __buildCommsRegData__(reg, false);
+    mySPI::selectProfile(_spiPort, _profileId);
     gpio_put(_csPin, false);
-    spi_write_blocking(_spiPort, &commsRegData, 1);
+    mySPI::write_blocking(_spiPort, &commsRegData, 1);
     gpio_put(_csPin, true);
     gpio_put(_csPin, false);
-    spi_write_blocking(_spiPort, &value, 1);
+    mySPI::write_blocking(_spiPort, &value, 1);
     gpio_put(_csPin, true);
 }
 
 uint8_t myMAX1415::__readReg__(const uint8_t reg) {
     uint8_t returnValue;
     uint8_t commsRegData = __buildCommsRegData__(reg, true);
+    mySPI::selectProfile(_spiPort, _profileId);
     gpio_put(_csPin, false);
-    spi_write_blocking(_spiPort, &commsRegData, 1);
+    mySPI::write_blocking(_spiPort, &commsRegData, 1);
     gpio_put(_csPin, true);
     gpio_put(_csPin, false);
-    spi_read_blocking(_spiPort, 0x00, &returnValue, 1);
+    mySPI::read_blocking(_spiPort, 0x00, &returnValue, 1);
     gpio_put(_csPin, true);
     return returnValue;
 }
 
 uint16_t myMAX1415::__readData__() {
     uint16_t returnValue;
-    uint8_t dataBuffer[2];
     uint8_t commsRegData = __buildCommsRegData__(REG_DATA, true);
+    mySPI::selectProfile(_spiPort, _profileId);
     gpio_put(_csPin, false);
-    spi_write_blocking(_spiPort, &commsRegData, 1);
+    mySPI::write_blocking(_spiPort, &commsRegData, 1);
     gpio_put(_csPin, true);
+    mySPI::selectProfile(_spiPort, _profileId16);
     gpio_put(_csPin, false);
-    spi_read_blocking(_spiPort, 0x00, dataBuffer, 2);
+    mySPI::read16_blocking(_spiPort, 0x0000, &returnValue, 1);
     gpio_put(_csPin, true);
-    returnValue = (uint16_t)(dataBuffer[0] << 8);
-    returnValue |= (uint16_t)dataBuffer[1];
     return returnValue;
 }
 
@@ -639,12 +654,13 @@ bool myMAX1415::__poll_hw__() {
 
 bool myMAX1415::__poll_sw__() {
     uint8_t commsRegData = __buildCommsRegData__(REG_COMMS, true);
+    mySPI::selectProfile(_spiPort, _profileId);
 // Set comms reg data
     gpio_put(_csPin, false);
-    spi_write_blocking(_spiPort, &commsRegData, 1);
+    mySPI::write_blocking(_spiPort, &commsRegData, 1);
     gpio_put(_csPin, true);
     gpio_put(_csPin,false);
-    spi_read_blocking(_spiPort, 0x00, &commsRegData, 1);
+    mySPI::read_blocking(_spiPort, 0x00, &commsRegData, 1);
     gpio_put(_csPin, true);
     return ! (bool)(commsRegData & MASK_DRDY);
 }
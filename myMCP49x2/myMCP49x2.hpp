@@ -262,7 +262,9 @@ class myMCP49x2 {
          * Initialize the chip. Returns 0 (NO_ERROR) for initialized okay, otherwise if an invalid
          * pin is passed during construction an error code is returned.
          * @param model Model number, one of MODEL_* values.
-         * @param initSPI True = init spi bus, False assumes it's already initialized at max 20MHz.
+         * In hardware SPI mode a 16 bit frame profile is registered on the port, and selected for each
+         * write.
+         * @param initSPI True = init spi bus, False assumes it's already initialized at max 20MHz. Skipped if the port is already initialized.
          * @return int16_t Returns 0 for initialized okay. Negative for error code.
          */
         int16_t initialize(const models model, const bool initSPI=true);
@@ -284,6 +286,7 @@ class myMCP49x2 {
     // SPI 
         spi_inst_t *_spiPort;
         bool _useHWSPI = true;
+        int16_t _profileId = -1;        // 16 bit frame profile.
     // Model:
         models _model;
     // Settings:
@@ -396,13 +399,15 @@ int16_t myMCP49x2::enableDAC(const bool value, const bool resetValue, const bool
 
 int16_t myMCP49x2::initialize(const models model, const bool initSPI) {
     int16_t returnValue;
-    uint32_t pinMask;
+    uint32_t pinMask = 0;
     _model = model; // Store model #
 // Init SPI:
     if (initSPI == true) {
         if (_useHWSPI == true) {
-            returnValue = mySPI::initializeMaster(_spiPort, _sckPin, _misoPin, _mosiPin, 20000*1000);
-            if (returnValue < 0) { return returnValue; }
+            if (mySPI::getPortInit(_spiPort) == false) {
+                returnValue = mySPI::initializeMaster(_spiPort, _sckPin, _misoPin, _mosiPin, 20000*1000);
+                if (returnValue < 0) { return returnValue; }
+            }
         } else {
         // Check pins:
             if (myHelpers::isPin(_sckPin) == false) { return ERROR_INVALID_PIN; }
@@ -411,6 +416,15 @@ int16_t myMCP49x2::initialize(const models model, const bool initSPI) {
             pinMask |= (1 << _sckPin) | ( 1 << _mosiPin);
         }
     }
+// Register a 16 bit frame profile once, so each write is a single FIFO entry:
+    if (_useHWSPI == true and _profileId < 0) {
+        mySPI::profile_t profile;
+        profile.baudRate = 20000*1000;
+        profile.dataBits = 16;
+        returnValue = mySPI::registerProfile(_spiPort, profile);
+        if (returnValue < 0) { return returnValue; }
+        _profileId = returnValue;
+    }
 // Check pins:
     if (myHelpers::isPin(_csPin) == false) { return ERROR_INVALID_PIN; }
     pinMask |= (1 << _csPin);
@@ -430,7 +444,7 @@ int16_t myMCP49x2::initialize(const models model, const bool initSPI) {
 
 
 uint16_t myMCP49x2::__getSettings__(const bool channel) {
-    uint16_t settings;
+    uint16_t settings = 0;
     uint8_t index = (uint8_t)channel;
     if (channel == true) { settings |= AB_MASK; }
     if (_buff[index] == true) { settings |= BUFF_MASK; }
@@ -457,16 +471,17 @@ uint16_t myMCP49x2::__shiftValue__(const uint16_t value) {
 
 void myMCP49x2::__writeDAC__(const bool channel) {
     int16_t returnValue;
-    uint8_t dataBuffer[2];
     uint8_t index = (uint8_t)channel;
     uint16_t outValue = __getSettings__(channel);
     outValue |= __shiftValue__(_values[index]);
-    dataBuffer[0] = (uint8_t)(outValue >> 8);
-    dataBuffer[1] = (uint8_t)outValue;
+    if (_useHWSPI == true) { mySPI::selectProfile(_spiPort, _profileId); }
     gpio_put(_csPin, false);
     if (_useHWSPI == true) {
-        spi_write_blocking(_spiPort, dataBuffer, 2);
+        mySPI::write16_blocking(_spiPort, &outValue, 1);
     } else {
+        uint8_t dataBuffer[2];
+        dataBuffer[0] = (uint8_t)(outValue >> 8);
+        dataBuffer[1] = (uint8_t)outValue;
         returnValue = myHelpers::shiftOut(_sckPin, _mosiPin, dataBuffer, 2);
         if (returnValue < 0) {
             printf("Shift out error code: %i\n", returnValue);
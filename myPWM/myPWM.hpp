@@ -390,6 +390,20 @@ namespace myPWM {
         __setPinInit__(pin, true);
         return NO_ERROR;
     }
+    /**
+     * @brief Initialize a pin validated at compile time as PWM.
+     * An invalid pin fails to compile, so only the pin state is checked. IE: myPWM::initializePin<15>();
+     * @tparam PIN Pin to initialize.
+     * @return int16_t Returns 0 (NO_ERROR) for initialized okay, or negative for error code.
+     */
+    template <uint8_t PIN>
+    int16_t initializePin() {
+        static_assert(myHelpers::isPin(PIN), "Invalid pin.");
+        if (getPinInit(PIN) == true) { return ERROR_PIN_ALEREADY_INIT; }
+        gpio_set_function(PIN, GPIO_FUNC_PWM);
+        __setPinInit__(PIN, true);
+        return NO_ERROR;
+    }
     /**
      * @brief Deinitialize a pin.
      * Deinitialize a pin. Sets gpio funciton to NULL. It will return 0 if deinitialized okay. If
@@ -18,6 +18,7 @@
 #include "../myStandardDefines.hpp"
 #include "../myErrorCodes.hpp"
 #include "../myHelpers.hpp"
+#include "../mySPI/mySPI.hpp"
 /**
  * @brief A Class to use a 595 shift register.
  *      Use startWrite to start a write to the shift register, then writeBit or writeByte to send data to 
@@ -223,9 +224,10 @@ class my595 {
         uint8_t       _pwmChannel;
         bool          _usePWM = false;
         bool          _useHardware = false;
+        int16_t       _profileId = -1;  // mySPI profile.
     /* Functions: */
         void __initDataPinsGPIO__();
-        void __initSPI__();
+        int16_t __initSPI__();
         void __initClearPin__();
         bool __initEnableGPIO__(const bool value);
         bool __initEnablePWM__(const uint8_t value);
@@ -240,7 +242,8 @@ int16_t my595::initialize() {
     if (_useHardware == false) {
         __initDataPinsGPIO__();
     } else {
-        __initSPI__();
+        int16_t returnValue = __initSPI__();
+        if (returnValue < 0) { return returnValue; }
     }
 // Init clear pin
     __initClearPin__();
@@ -259,7 +262,8 @@ int16_t my595::initialize(const bool enable) {
     if (_useHardware == false) {
         __initDataPinsGPIO__();
     } else {
-        __initSPI__();
+        int16_t returnValue = __initSPI__();
+        if (returnValue < 0) { return returnValue; }
     }
 // Init clear pin
     __initClearPin__();
@@ -279,7 +283,8 @@ int16_t my595::initialize(const uint8_t enable) {
     if (_useHardware == false) {
         __initDataPinsGPIO__();
     } else {
-        __initSPI__();
+        int16_t returnValue = __initSPI__();
+        if (returnValue < 0) { return returnValue; }
     }
 // Init clear pin
     __initClearPin__();
@@ -322,7 +327,8 @@ void my595::writeByte(const uint8_t value, const bool bitOrder) {
         if (bitOrder == LSB_FIRST) {
             val = myHelpers::reverse8(value);
         }
-        spi_write_blocking(_spiPort, &val, 1);
+        mySPI::selectProfile(_spiPort, _profileId);
+        mySPI::write_blocking(_spiPort, &val, 1);
     }
 }
 
@@ -378,11 +384,21 @@ void my595::__initDataPinsGPIO__() {
     gpio_put(_dataTXPin, false);
 }
 
-void my595::__initSPI__() {
-    spi_init(_spiPort, 1000*5000); // init spi at 5 Mhz.
-    gpio_set_function(_clkPin,  GPIO_FUNC_SPI); // set sck as spi.
-    gpio_set_function(_dataTXPin, GPIO_FUNC_SPI); // set data (mosi) as spi.
-    gpio_set_function(_dataRXPin, GPIO_FUNC_SPI); // Set mosi as spi.
+int16_t my595::__initSPI__() {
+    int32_t returnValue;
+    if (mySPI::getPortInit(_spiPort) == false) {
+        returnValue = mySPI::initializeMaster(_spiPort, _clkPin, _dataRXPin, _dataTXPin, 1000*5000); // init spi at 5 Mhz.
+        if (returnValue < 0) { return (int16_t)returnValue; }
+    }
+// Register a profile once, so the port is back at our speed and 8 bit frames for each write:
+    if (_profileId < 0) {
+        mySPI::profile_t profile;
+        profile.baudRate = 1000*5000;
+        returnValue = mySPI::registerProfile(_spiPort, profile);
+        if (returnValue < 0) { return (int16_t)returnValue; }
+        _profileId = (int16_t)returnValue;
+    }
+    return NO_ERROR;
 }
 
 void my595::__initClearPin__() {
@@ -11,9 +11,13 @@
 #ifndef MY_SPI_H
 #define MY_SPI_H
 #include <hardware/spi.h>
+#include <hardware/dma.h>
+#include <hardware/sync.h>
+#include <hardware/timer.h>
 #include "../myStandardDefines.hpp"
 #include "../myErrorCodes.hpp"
 #include "../myHelpers.hpp"
+#include "../mySpinLock/mySpinLock.hpp"
 /**
  * @brief SPI helper functions.
  * 
@@ -24,13 +28,13 @@ namespace mySPI {
  */
 // Pin mappings:
     /** @private */
-    static const uint8_t _misoPins[MY_SPI_NUM_PORTS][MY_SPI_NUM_PINS] = { {0, 4, 16, 20}, {8, 12, 24, 28} };
+    static constexpr uint8_t _misoPins[MY_SPI_NUM_PORTS][MY_SPI_NUM_PINS] = { {0, 4, 16, 20}, {8, 12, 24, 28} };
     /** @private */
-    static const uint8_t _mosiPins[MY_SPI_NUM_PORTS][MY_SPI_NUM_PINS] = { {3, 7, 19, 23}, {11, 15, 27, MY_NOT_A_PIN} };
+    static constexpr uint8_t _mosiPins[MY_SPI_NUM_PORTS][MY_SPI_NUM_PINS] = { {3, 7, 19, 23}, {11, 15, 27, MY_NOT_A_PIN} };
     /** @private */
-    static const uint8_t _sckPins[MY_SPI_NUM_PORTS][MY_SPI_NUM_PINS] = { {2, 6, 18, 22}, {10, 14, 26, MY_NOT_A_PIN} };
+    static constexpr uint8_t _sckPins[MY_SPI_NUM_PORTS][MY_SPI_NUM_PINS] = { {2, 6, 18, 22}, {10, 14, 26, MY_NOT_A_PIN} };
     /** @private */
-    static const uint8_t _csPins[MY_SPI_NUM_PORTS][MY_SPI_NUM_PINS] = { {1, 5, 17, 21}, {9, 13, 25, 29} };
+    static constexpr uint8_t _csPins[MY_SPI_NUM_PORTS][MY_SPI_NUM_PINS] = { {1, 5, 17, 21}, {9, 13, 25, 29} };
 // Error codes:
     /**
      * @brief No error. Value 0.
@@ -67,6 +71,68 @@ namespace mySPI {
      * The SPI port is not initialized when de init called.
      */
     static const int16_t ERROR_NOT_INITIALIZED = MY_ERROR_SPI_NOT_INITIALIZED;
+    /**
+     * @brief Transaction queue full. Value -156.
+     * The transaction queue was full when a transaction was submitted.
+     */
+    static const int16_t ERROR_QUEUE_FULL = MY_ERROR_SPI_QUEUE_FULL;
+    /**
+     * @brief Profile table full. Value -157.
+     * No free profile slot was available.
+     */
+    static const int16_t ERROR_PROFILES_FULL = MY_ERROR_SPI_PROFILES_FULL;
+    /**
+     * @brief Invalid profile. Value -158.
+     * The profile id is not registered, or belongs to another port.
+     */
+    static const int16_t ERROR_INVALID_PROFILE = MY_ERROR_SPI_INVALID_PROFILE;
+    /**
+     * @brief Value error. Value -9.
+     * A value is out of range.
+     */
+    static const int16_t ERROR_VALUE = MY_VALUE_ERROR;
+    /**
+     * @brief Port busy. Value -161.
+     * The port was owned by the other core until the acquire timed out.
+     */
+    static const int16_t ERROR_PORT_BUSY = MY_ERROR_SPI_PORT_BUSY;
+    /**
+     * @brief Not port owner. Value -162.
+     * The port was released by a core that doesn't own it.
+     */
+    static const int16_t ERROR_NOT_OWNER = MY_ERROR_SPI_NOT_OWNER;
+// Port ownership priorities:
+    /**
+     * @brief Low priority acquire.
+     * Yields a free port to a waiting normal or high priority acquire.
+     */
+    static const uint8_t PRIORITY_LOW = 0;
+    /**
+     * @brief Normal priority acquire.
+     */
+    static const uint8_t PRIORITY_NORMAL = 1;
+    /**
+     * @brief High priority acquire.
+     * Takes a free port ahead of a waiting low or normal priority acquire.
+     */
+    static const uint8_t PRIORITY_HIGH = 2;
+    /**
+     * @brief Queue port owner.
+     * Returned by getPortOwner() while a mySPIQueue is running transactions on the port.
+     */
+    static const int8_t OWNER_QUEUE = 2;
+    /**
+     * @brief Timer port owner.
+     * Returned by getPortOwner() while a driver polls a device on the port from a timer interrupt.
+     */
+    static const int8_t OWNER_TIMER = 3;
+    /** @private */
+    static const uint8_t _FIFO_DEPTH = 8;                           // Shorter transfers skip DMA.
+    /**
+     * @brief Shortest DMA transfer.
+     * The *_dma_* calls send shorter transfers through the FIFO.
+     */
+    static const uint8_t DMA_MIN_LENGTH = _FIFO_DEPTH;
 // Pin type ids:
     /** @private */
     static const uint8_t _PIN_CLOCK = 0;
@@ -76,6 +142,44 @@ namespace mySPI {
     static const uint8_t _PIN_MOSI = 2;
     /** @private */
     static const uint8_t _PIN_CS = 3;
+/*
+ * ########################## Types: ##############################
+ */
+    /**
+     * @brief Device profile.
+     * Bus settings for one device on a shared port. Registered with registerProfile(), and applied
+     * by selectProfile() only when the active device changes.
+     */
+    struct profile_t {
+        uint32_t baudRate;                  // Requested baud rate in Hz.
+        uint8_t dataBits = 8;               // Frame size, 4-16 bits.
+        spi_cpol_t cpol = SPI_CPOL_0;       // Clock polarity.
+        spi_cpha_t cpha = SPI_CPHA_0;       // Clock phase.
+        uint8_t csPin = MY_NOT_A_PIN;       // Chip select pin, active low. MY_NOT_A_PIN for none.
+    };
+    /**
+     * @brief Port contention counters.
+     * Returned by getPortStats(), cleared by resetPortStats().
+     */
+    struct portStats_t {
+        uint32_t acquires = 0;              // Successful acquires, not counting nested ones.
+        uint32_t contended = 0;             // Acquires that had to wait for the other core.
+        uint32_t timeouts = 0;              // Acquires that timed out.
+        uint32_t maxWaitUs = 0;             // Longest wait for a successful acquire.
+    };
+#ifdef MY_SPI_STATS
+    /**
+     * @brief Transfer counters.
+     * Per port counters, kept when MY_SPI_STATS is defined before including. Returned by getStats(),
+     * cleared by resetStats().
+     */
+    struct stats_t {
+        uint64_t bytes = 0;                 // Bytes transfered, 16 bit frames count as 2.
+        uint32_t transactions = 0;          // Transfer calls.
+        uint64_t busyUs = 0;                // Time spent blocked in transfer calls.
+        uint32_t maxLatencyUs = 0;          // Longest single transfer call.
+    };
+#endif
 /* 
  * ######################### Variables: ############################
  */
@@ -86,9 +190,65 @@ namespace mySPI {
     };
     /** @private */
     uint8_t _status = 0b00001100;
+    /** @private */
+    int _dmaTxChannels[MY_SPI_NUM_PORTS] = { -1, -1 };              // DMA channels, claimed on first use.
+    /** @private */
+    int _dmaRxChannels[MY_SPI_NUM_PORTS] = { -1, -1 };
+    /** @private */
+    uint8_t _dmaBuffers[MY_SPI_NUM_PORTS][2][MY_SPI_DMA_CHUNK_SIZE] __attribute__((aligned(4))); // Double buffered staging for reversed data.
+    /** @private */
+    uint16_t _dmaSink;                                              // Discarded rx data on writes.
+    /** @private */
+    uint8_t _dmaRepeats[MY_SPI_NUM_PORTS];                          // Data sent by reads left running.
+    /** @private */
+    profile_t _profiles[MY_SPI_MAX_PROFILES];
+    /** @private */
+    uint8_t _profilePorts[MY_SPI_MAX_PROFILES];                     // Port index of each profile.
+    /** @private */
+    uint8_t _numProfiles = 0;
+    /** @private */
+    int16_t _activeProfiles[MY_SPI_NUM_PORTS] = { -1, -1 };        // Profile last selected on each port.
+    /** @private */
+    uint32_t _appliedBaudRates[MY_SPI_NUM_PORTS] = { 0, 0 };       // Baud rate last applied to each port.
+    /** @private */
+    uint16_t _appliedFormats[MY_SPI_NUM_PORTS] = { 0, 0 };         // Packed format last applied to each port.
+    /** @private */
+    int16_t _portLockNums[MY_SPI_NUM_PORTS] = { -1, -1 };          // Spin lock guarding each port's owner.
+    /** @private */
+    volatile int8_t _portOwners[MY_SPI_NUM_PORTS] = { -1, -1 };    // Core, OWNER_QUEUE or OWNER_TIMER owning each port, -1 for none.
+    /** @private */
+    volatile uint8_t _portDepths[MY_SPI_NUM_PORTS] = { 0, 0 };     // Nested acquires by the owner.
+    /** @private */
+    volatile uint8_t _portWaiting[MY_SPI_NUM_PORTS][2] = { {0, 0}, {0, 0} }; // Waiting priority + 1 by core, 0 for none.
+    /** @private */
+    portStats_t _portStats[MY_SPI_NUM_PORTS];
+    /** @private */
+    typedef void (*portResume_t)(void *userData);                   // Called when a port is freed.
+    /** @private */
+    portResume_t _portResumeHooks[MY_SPI_NUM_PORTS] = { nullptr, nullptr };
+    /** @private */
+    void *_portResumeData[MY_SPI_NUM_PORTS] = { nullptr, nullptr };
+#ifdef MY_SPI_STATS
+    /** @private */
+    stats_t _stats[MY_SPI_NUM_PORTS];
+    /** @private */
+    uint64_t _dmaStartTimes[MY_SPI_NUM_PORTS];                      // Start of the transfer left running.
+    /** @private */
+    size_t _dmaPendingBytes[MY_SPI_NUM_PORTS] = { 0, 0 };          // Bytes of the transfer left running, 0 for none.
+#endif
 /*
  * ########################### Validation functions: ##################
  */
+    /** @private */
+    constexpr bool __isPortPin__(const uint8_t (&pins)[MY_SPI_NUM_PORTS][MY_SPI_NUM_PINS],
+                                    const uint8_t spiIndex, const uint8_t pin) {
+        if (myHelpers::isPin(pin) == false) { return false; }
+        if (spiIndex >= MY_SPI_NUM_PORTS) { return false; }
+        for (uint8_t i=0; i<MY_SPI_NUM_PINS; i++) {
+            if (pin == pins[spiIndex][i]) { return true; }
+        }
+        return false;
+    }
     /**
      * @brief Validate a clock pin for given spi port.
      * Returns true if the supplied pin is a clock pin for the spi port, and false if not, or the
@@ -99,12 +259,7 @@ namespace mySPI {
      * @return false Pin is not a valid clock pin, or is not a vaild pin.
      */
     bool isClockPin(spi_inst_t *spiPort, const uint8_t pin) {
-        if (myHelpers::isPin(pin) == false) { return false; }
-        const uint8_t spiIndex = spi_get_index(spiPort);
-        for (uint8_t i=0; i<MY_SPI_NUM_PINS; i++) {
-            if (pin == _sckPins[spiIndex][i]) { return true; }
-        }
-        return false;
+        return __isPortPin__(_sckPins, spi_get_index(spiPort), pin);
     }
     /**
      * @brief Is a MISO pin.
@@ -116,12 +271,7 @@ namespace mySPI {
      * @return false Pin is not a valid MISO pin, or the pin is invalid.
      */
     bool isMisoPin(spi_inst_t *spiPort, const uint8_t pin) {
-        if (myHelpers::isPin(pin) == false) { return false; }
-        const uint8_t spiIndex = spi_get_index(spiPort);
-        for (uint8_t i=0; i<MY_SPI_NUM_PINS; i++) {
-            if (pin == _misoPins[spiIndex][i]) { return true; }
-        }
-        return false;
+        return __isPortPin__(_misoPins, spi_get_index(spiPort), pin);
     }
     /**
      * @brief Is a MOSI pin.
@@ -133,12 +283,7 @@ namespace mySPI {
      * @return false Pin is not a valid MOSI pin, or the pin is invalid.
      */
     bool isMosiPin(spi_inst_t *spiPort, const uint8_t pin) {
-        if (myHelpers::isPin(pin) == false) { return false; }
-        const uint8_t spiIndex = spi_get_index(spiPort);
-        for (uint8_t i=0; i<MY_SPI_NUM_PINS; i++) {
-            if (pin == _mosiPins[spiIndex][i]) { return true; }
-        }
-        return false;
+        return __isPortPin__(_mosiPins, spi_get_index(spiPort), pin);
     }
     /**
      * @brief Is a chip select pin.
@@ -150,13 +295,46 @@ namespace mySPI {
      * @return false Pin is not a valid chip select pin, or is invalid.
      */
     bool isChipSelectPin(spi_inst_t *spiPort, const uint8_t pin) {
-        if (myHelpers::isPin(pin) == false) { return false; }
-        const uint8_t spiIndex = spi_get_index(spiPort);
-        for (uint8_t i=0; i<MY_SPI_NUM_PINS; i++) {
-            if (pin == _csPins[spiIndex][i]) { return true; }
-        }
-        return false;
+        return __isPortPin__(_csPins, spi_get_index(spiPort), pin);
     }
+/*
+ * ########################### Pin configurations: ##################
+ */
+    /**
+     * @brief Master pin configuration, validated at compile time.
+     * An invalid pin for the port fails to compile. Pass to initializeMaster<>(), which then skips
+     * the runtime pin checks. IE: mySPI::initializeMaster<mySPI::masterPins_t<0, 18, 16, 19>>(baud);
+     * @tparam SPI_INDEX SPI port number, 0 or 1.
+     * @tparam CLOCK_PIN Clock pin.
+     * @tparam MISO_PIN MISO pin.
+     * @tparam MOSI_PIN MOSI pin.
+     */
+    template <uint8_t SPI_INDEX, uint8_t CLOCK_PIN, uint8_t MISO_PIN, uint8_t MOSI_PIN>
+    struct masterPins_t {
+        static_assert(SPI_INDEX < MY_SPI_NUM_PORTS, "Invalid SPI port.");
+        static_assert(__isPortPin__(_sckPins, SPI_INDEX, CLOCK_PIN), "Invalid clock pin for SPI port.");
+        static_assert(__isPortPin__(_misoPins, SPI_INDEX, MISO_PIN), "Invalid MISO pin for SPI port.");
+        static_assert(__isPortPin__(_mosiPins, SPI_INDEX, MOSI_PIN), "Invalid MOSI pin for SPI port.");
+        static constexpr uint8_t spiIndex = SPI_INDEX;
+        static constexpr uint8_t clockPin = CLOCK_PIN;
+        static constexpr uint8_t misoPin = MISO_PIN;
+        static constexpr uint8_t mosiPin = MOSI_PIN;
+    };
+    /**
+     * @brief Slave pin configuration, validated at compile time.
+     * An invalid pin for the port fails to compile. Pass to initializeSlave<>(), which then skips
+     * the runtime pin checks.
+     * @tparam SPI_INDEX SPI port number, 0 or 1.
+     * @tparam CLOCK_PIN Clock pin.
+     * @tparam MISO_PIN MISO pin.
+     * @tparam MOSI_PIN MOSI pin.
+     * @tparam CS_PIN Chip select pin.
+     */
+    template <uint8_t SPI_INDEX, uint8_t CLOCK_PIN, uint8_t MISO_PIN, uint8_t MOSI_PIN, uint8_t CS_PIN>
+    struct slavePins_t : masterPins_t<SPI_INDEX, CLOCK_PIN, MISO_PIN, MOSI_PIN> {
+        static_assert(__isPortPin__(_csPins, SPI_INDEX, CS_PIN), "Invalid chip select pin for SPI port.");
+        static constexpr uint8_t csPin = CS_PIN;
+    };
 /*
  *######################### Public status functions: #######################
  */
@@ -254,6 +432,103 @@ namespace mySPI {
         _portPins[spiIndex][_PIN_MOSI] = mosiPin;
         _portPins[spiIndex][_PIN_CS] = csPin;
     }
+    /** @private */
+    uint16_t inline __packFormat__(const uint8_t dataBits, const spi_cpol_t cpol, const spi_cpha_t cpha) {
+        return (uint16_t)((dataBits << 2) | (cpol << 1) | cpha);
+    }
+    /** @private */
+    void __setApplied__(spi_inst_t *spiPort, const uint32_t baudRate, const uint16_t format) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        _appliedBaudRates[spiIndex] = baudRate;
+        _appliedFormats[spiIndex] = format;
+        _activeProfiles[spiIndex] = -1;
+    }
+    /** @private */
+    void __claimPortLock__(spi_inst_t *spiPort) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_portLockNums[spiIndex] >= 0) { return; }   // Kept across deinit and reinit.
+        mySpinLock lock(mySpinLock::GENERATE_LOCK_NUM);
+        _portLockNums[spiIndex] = lock.getLockNum();
+    }
+    /** @private */
+    void __claimDma__(spi_inst_t *spiPort) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_dmaTxChannels[spiIndex] < 0) { _dmaTxChannels[spiIndex] = dma_claim_unused_channel(true); }
+        if (_dmaRxChannels[spiIndex] < 0) { _dmaRxChannels[spiIndex] = dma_claim_unused_channel(true); }
+    }
+    /** @private */
+    void __releaseDma__(spi_inst_t *spiPort) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_dmaTxChannels[spiIndex] >= 0) {
+            dma_channel_unclaim(_dmaTxChannels[spiIndex]);
+            _dmaTxChannels[spiIndex] = -1;
+        }
+        if (_dmaRxChannels[spiIndex] >= 0) {
+            dma_channel_unclaim(_dmaRxChannels[spiIndex]);
+            _dmaRxChannels[spiIndex] = -1;
+        }
+    }
+    /** @private */
+    void __configureDma__(spi_inst_t *spiPort, const uint txChannel, const uint rxChannel, const void *src,
+                            const bool srcIncrement, void *dst, const bool dstIncrement, const size_t len,
+                            const dma_channel_transfer_size size=DMA_SIZE_8) {
+        dma_channel_config txConfig = dma_channel_get_default_config(txChannel);
+        channel_config_set_transfer_data_size(&txConfig, size);
+        channel_config_set_read_increment(&txConfig, srcIncrement);
+        channel_config_set_write_increment(&txConfig, false);
+        channel_config_set_dreq(&txConfig, spi_get_dreq(spiPort, true));
+        channel_config_set_sniff_enable(&txConfig, true);              // Seen only while the sniffer selects it.
+        dma_channel_config rxConfig = dma_channel_get_default_config(rxChannel);
+        channel_config_set_transfer_data_size(&rxConfig, size);
+        channel_config_set_read_increment(&rxConfig, false);
+        channel_config_set_write_increment(&rxConfig, dstIncrement);
+        channel_config_set_dreq(&rxConfig, spi_get_dreq(spiPort, false));
+        channel_config_set_sniff_enable(&rxConfig, true);
+        dma_channel_configure(rxChannel, &rxConfig, dst, &spi_get_hw(spiPort)->dr, len, false);
+        dma_channel_configure(txChannel, &txConfig, &spi_get_hw(spiPort)->dr, src, len, false);
+        dma_start_channel_mask((1u << txChannel) | (1u << rxChannel)); // Start both together.
+    }
+    /** @private */
+    void __startDma__(spi_inst_t *spiPort, const void *src, const bool srcIncrement, void *dst,
+                        const bool dstIncrement, const size_t len, const dma_channel_transfer_size size=DMA_SIZE_8) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        __configureDma__(spiPort, _dmaTxChannels[spiIndex], _dmaRxChannels[spiIndex], src, srcIncrement,
+                            dst, dstIncrement, len, size);
+    }
+    /** @private */
+    void __waitDma__(spi_inst_t *spiPort) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        // Every byte sent clocks a byte in, so rx finishing means the transfer is complete.
+        dma_channel_wait_for_finish_blocking(_dmaRxChannels[spiIndex]);
+    }
+    /** @private */
+    int32_t __initializeMaster__(spi_inst_t *spiPort, const uint8_t clockPin, const uint8_t misoPin,
+                                    const uint8_t mosiPin, const uint32_t baudRate) {
+        const int32_t achievedRate = spi_init(spiPort, baudRate);
+        gpio_set_function(clockPin, GPIO_FUNC_SPI);
+        gpio_set_function(misoPin, GPIO_FUNC_SPI);
+        gpio_set_function(mosiPin, GPIO_FUNC_SPI);
+        __setPins__(spiPort, clockPin, misoPin, mosiPin, MY_NOT_A_PIN);
+        __setMaster__(spiPort, true);
+        __setPortInit__(spiPort, true);
+        __claimPortLock__(spiPort);
+        __setApplied__(spiPort, baudRate, __packFormat__(8, SPI_CPOL_0, SPI_CPHA_0)); // spi_init defaults.
+        return achievedRate;
+    }
+    /** @private */
+    int32_t __initializeSlave__(spi_inst_t *spiPort, const uint8_t clockPin, const uint8_t misoPin,
+                                    const uint8_t mosiPin, const uint8_t chipSelectPin, const uint32_t baudRate) {
+        const int32_t achievedRate = spi_init(spiPort, baudRate);
+        gpio_set_function(clockPin, GPIO_FUNC_SPI);
+        gpio_set_function(misoPin, GPIO_FUNC_SPI);
+        gpio_set_function(mosiPin, GPIO_FUNC_SPI);
+        gpio_set_function(chipSelectPin, GPIO_FUNC_SPI);
+        __setPins__(spiPort, clockPin, misoPin, mosiPin, chipSelectPin);
+        __setMaster__(spiPort, false);
+        __setPortInit__(spiPort, true);
+        __claimPortLock__(spiPort);
+        return achievedRate;
+    }
 /*
  * ########################## Initialize functions: ##########################
  */
@@ -273,18 +548,26 @@ namespace mySPI {
         if (isClockPin(spiPort, clockPin) == false) { return ERROR_INVALID_CLOCK_PIN; }
         if (isMisoPin(spiPort, misoPin) == false) { return ERROR_INVALID_MISO_PIN; }
         if (isMosiPin(spiPort, mosiPin) == false) { return ERROR_INVALID_MOSI_PIN; }
-        const int32_t achievedRate = spi_init(spiPort, baudRate);
-        gpio_set_function(clockPin, GPIO_FUNC_SPI);
-        gpio_set_function(misoPin, GPIO_FUNC_SPI);
-        gpio_set_function(mosiPin, GPIO_FUNC_SPI);
-        __setPins__(spiPort, clockPin, misoPin, mosiPin, MY_NOT_A_PIN);
-        __setMaster__(spiPort, true);
-        return achievedRate;
+        return __initializeMaster__(spiPort, clockPin, misoPin, mosiPin, baudRate);
+    }
+    /**
+     * @brief Initialize SPI port in master mode, with pins validated at compile time.
+     * Only checks that the port isn't already initialized.
+     * @tparam PINS masterPins_t pin configuration.
+     * @param baudRate Requested baud rate in Hz.
+     * @return int32_t Returns positive, for achieved baud rate, negative for error code.
+     */
+    template <class PINS>
+    int32_t initializeMaster(const uint32_t baudRate) {
+        spi_inst_t *spiPort = (PINS::spiIndex == 0) ? spi0 : spi1;
+        if (getPortInit(spiPort) == true) { return ERROR_INITIALIZED; }
+        return __initializeMaster__(spiPort, PINS::clockPin, PINS::misoPin, PINS::mosiPin, baudRate);
     }
     /**
      * @brief Initialize a SPI port in slave mode.
      * Initialize a SPI port in slave mode. Returns positive for achieved baud rate. Otherwise if
      * an invalid pin, or if the port is already initialized, an error code will be returned.
+     * @note Use mySPISlave for a DMA driven data path on the port.
      * @param spiPort SPI port instance to initialize.
      * @param clockPin Clock pin.
      * @param misoPin MISO pin.
@@ -301,14 +584,21 @@ namespace mySPI {
         if (isMisoPin(spiPort, misoPin) == false) { return ERROR_INVALID_MISO_PIN; }
         if (isMosiPin(spiPort, mosiPin) == false) { return ERROR_INVALID_MOSI_PIN; }
         if (isChipSelectPin(spiPort, chipSelectPin) == false) { return ERROR_INVALID_CS_PIN; }
-        const int32_t achievedRate = spi_init(spiPort, baudRate);
-        gpio_set_function(clockPin, GPIO_FUNC_SPI);
-        gpio_set_function(misoPin, GPIO_FUNC_SPI);
-        gpio_set_function(mosiPin, GPIO_FUNC_SPI);
-        gpio_set_function(chipSelectPin, GPIO_FUNC_SPI);
-        __setPins__(spiPort, clockPin, misoPin, mosiPin, chipSelectPin);
-        __setMaster__(spiPort, false);
-        return achievedRate;
+        return __initializeSlave__(spiPort, clockPin, misoPin, mosiPin, chipSelectPin, baudRate);
+    }
+    /**
+     * @brief Initialize a SPI port in slave mode, with pins validated at compile time.
+     * Only checks that the port isn't already initialized.
+     * @tparam PINS slavePins_t pin configuration.
+     * @param baudRate Requested baud rate in Hz.
+     * @return int32_t Returns positive for baud rate achieved, or negative for error code.
+     */
+    template <class PINS>
+    int32_t initializeSlave(const uint32_t baudRate) {
+        spi_inst_t *spiPort = (PINS::spiIndex == 0) ? spi0 : spi1;
+        if (getPortInit(spiPort) == true) { return ERROR_INITIALIZED; }
+        return __initializeSlave__(spiPort, PINS::clockPin, PINS::misoPin, PINS::mosiPin, PINS::csPin,
+                                    baudRate);
     }
     /**
      * @brief Deintialize SPI port.
@@ -326,33 +616,615 @@ namespace mySPI {
         if (myHelpers::isPin(getChipSelectPin(spiPort)) == true) {
             gpio_set_function(getChipSelectPin(spiPort), GPIO_FUNC_NULL);
         }
-        __setPins__(spiPort, MY_NOT_A_PIN, MY_NOT_A_PIN, MY_NO_ERROR, MY_NOT_A_PIN);
+        __releaseDma__(spiPort);
+        __setApplied__(spiPort, 0, 0);
+        __setPins__(spiPort, MY_NOT_A_PIN, MY_NOT_A_PIN, MY_NOT_A_PIN, MY_NOT_A_PIN);
+        __setPortInit__(spiPort, false);
         return NO_ERROR;
     }
+/*
+ * ######################### Profile functions: ######################
+ */
+    /**
+     * @brief Register a device profile.
+     * Stores the bus settings for a device on the given port, and returns an id to select it with.
+     * Several devices can share a port at their own speeds and modes. If the profile has a chip
+     * select pin, the pin is initialized as an output, and set high.
+     * @param spiPort SPI port the device is on.
+     * @param profile Bus settings for the device.
+     * @return int16_t Positive (including 0) for profile id, negative for error code.
+     */
+    int16_t registerProfile(spi_inst_t *spiPort, const profile_t &profile) {
+        if (profile.dataBits < 4 or profile.dataBits > 16) { return ERROR_VALUE; }
+        if (profile.baudRate == 0) { return ERROR_VALUE; }
+        if (_numProfiles == MY_SPI_MAX_PROFILES) { return ERROR_PROFILES_FULL; }
+        if (myHelpers::isPin(profile.csPin) == true) {
+            gpio_init(profile.csPin);
+            gpio_set_dir(profile.csPin, GPIO_OUT);
+            gpio_put(profile.csPin, true);
+        }
+        _profiles[_numProfiles] = profile;
+        _profilePorts[_numProfiles] = spi_get_index(spiPort);
+        return _numProfiles++;
+    }
+    /**
+     * @brief Select a device profile.
+     * Makes the profile the active one on its port. The baud rate and format are only written to the
+     * port when they differ from the last ones applied, so selecting the active profile again costs
+     * nothing.
+     * @param spiPort SPI port the profile was registered on.
+     * @param profileId Profile id returned by registerProfile().
+     * @return int16_t Returns 0 (NO_ERROR) if selected okay, negative for error code.
+     */
+    int16_t selectProfile(spi_inst_t *spiPort, const int16_t profileId) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (profileId == _activeProfiles[spiIndex]) { return NO_ERROR; }
+        if (profileId < 0 or profileId >= _numProfiles) { return ERROR_INVALID_PROFILE; }
+        if (_profilePorts[profileId] != spiIndex) { return ERROR_INVALID_PROFILE; }
+        if (getPortInit(spiPort) == false) { return ERROR_NOT_INITIALIZED; }
+        const profile_t &profile = _profiles[profileId];
+        if (profile.baudRate != _appliedBaudRates[spiIndex]) {
+            spi_set_baudrate(spiPort, profile.baudRate);
+            _appliedBaudRates[spiIndex] = profile.baudRate;
+        }
+        const uint16_t format = __packFormat__(profile.dataBits, profile.cpol, profile.cpha);
+        if (format != _appliedFormats[spiIndex]) {
+            spi_set_format(spiPort, profile.dataBits, profile.cpol, profile.cpha, SPI_MSB_FIRST);
+            _appliedFormats[spiIndex] = format;
+        }
+        _activeProfiles[spiIndex] = profileId;
+        return NO_ERROR;
+    }
+    /**
+     * @brief Get the active profile.
+     * Returns the id of the profile last selected on the port, or -1 if none is selected.
+     * @param spiPort SPI port instance.
+     * @return int16_t Profile id, or -1 for none.
+     */
+    int16_t getActiveProfile(spi_inst_t *spiPort) {
+        return _activeProfiles[spi_get_index(spiPort)];
+    }
+    /**
+     * @brief Begin a transaction with a device.
+     * Selects the profile, and lowers its chip select pin.
+     * @param spiPort SPI port the profile was registered on.
+     * @param profileId Profile id returned by registerProfile().
+     * @return int16_t Returns 0 (NO_ERROR) if started okay, negative for error code.
+     */
+    int16_t beginTransaction(spi_inst_t *spiPort, const int16_t profileId) {
+        const int16_t returnValue = selectProfile(spiPort, profileId);
+        if (returnValue < 0) { return returnValue; }
+        const uint8_t csPin = _profiles[profileId].csPin;
+        if (myHelpers::isPin(csPin) == true) { gpio_put(csPin, false); }
+        return NO_ERROR;
+    }
+    /**
+     * @brief End a transaction with a device.
+     * Raises the chip select pin of the profile.
+     * @param profileId Profile id returned by registerProfile().
+     * @return int16_t Returns 0 (NO_ERROR) if ended okay, negative for error code.
+     */
+    int16_t endTransaction(const int16_t profileId) {
+        if (profileId < 0 or profileId >= _numProfiles) { return ERROR_INVALID_PROFILE; }
+        const uint8_t csPin = _profiles[profileId].csPin;
+        if (myHelpers::isPin(csPin) == true) { gpio_put(csPin, true); }
+        return NO_ERROR;
+    }
+/*
+ * ######################### Port ownership functions: ######################
+ */
+    /** @private */
+    void __setPortResume__(spi_inst_t *spiPort, portResume_t hook, void *userData) {
+    // One hook per port, the port's mySPIQueue, so work left waiting for the port starts on release:
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        _portResumeData[spiIndex] = userData;
+        _portResumeHooks[spiIndex] = hook;
+    }
+    /** @private */
+    void __resumePort__(const uint8_t spiIndex) {
+        portResume_t hook = _portResumeHooks[spiIndex];
+        if (hook != nullptr) { hook(_portResumeData[spiIndex]); }
+    }
+    /**
+     * @brief Acquire ownership of a port.
+     * Lets both cores share a port, a core owns the port from acquirePort() to releasePort(), and
+     * runs its transactions in between. The spin lock is only held while the owner is checked, not
+     * while the port is owned, so interrupts stay enabled. Acquires by the owning core nest. A free
+     * port goes to the waiting core with the higher priority. Gives up after timeoutUs, 0 waits
+     * forever.
+     * @param spiPort SPI port instance.
+     * @param timeoutUs Timeout in microseconds, 0 for none.
+     * @param priority PRIORITY_LOW, PRIORITY_NORMAL, or PRIORITY_HIGH.
+     * @return int16_t Returns 0 (NO_ERROR) if acquired, negative for error code.
+     */
+    int16_t acquirePort(spi_inst_t *spiPort, const uint32_t timeoutUs=0, const uint8_t priority=PRIORITY_NORMAL) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_portLockNums[spiIndex] < 0) { return ERROR_NOT_INITIALIZED; }
+        if (priority > PRIORITY_HIGH) { return ERROR_VALUE; }
+        const uint8_t core = get_core_num();
+        const uint8_t otherCore = core ^ 1;
+        mySpinLock lock(_portLockNums[spiIndex]);       // Instance per call, so both cores can spin on it.
+        const uint32_t startTime = time_us_32();
+        bool waited = false;
+        while (true) {
+            lock.lockBlocking();
+            if (_portOwners[spiIndex] == core) {
+                _portDepths[spiIndex]++;
+                lock.unlock();
+                return NO_ERROR;
+            }
+            if (_portOwners[spiIndex] < 0 and _portWaiting[spiIndex][otherCore] <= (priority + 1)) {
+                const uint32_t waitTime = time_us_32() - startTime;
+                _portOwners[spiIndex] = core;
+                _portDepths[spiIndex] = 1;
+                _portWaiting[spiIndex][core] = 0;
+                _portStats[spiIndex].acquires++;
+                if (waited == true) { _portStats[spiIndex].contended++; }
+                if (waitTime > _portStats[spiIndex].maxWaitUs) { _portStats[spiIndex].maxWaitUs = waitTime; }
+                lock.unlock();
+                return NO_ERROR;
+            }
+            if (timeoutUs > 0 and (time_us_32() - startTime) >= timeoutUs) {
+                _portWaiting[spiIndex][core] = 0;
+                _portStats[spiIndex].timeouts++;
+                lock.unlock();
+                return ERROR_PORT_BUSY;
+            }
+            _portWaiting[spiIndex][core] = priority + 1;
+            waited = true;
+            lock.unlock();
+            tight_loop_contents();
+        }
+    }
+    /**
+     * @brief Release ownership of a port.
+     * Ends one acquirePort() by the calling core, the port is freed when the outermost one ends.
+     * A mySPIQueue with work waiting for the port starts it when the port is freed.
+     * @param spiPort SPI port instance.
+     * @return int16_t Returns 0 (NO_ERROR) if released, negative for error code.
+     */
+    int16_t releasePort(spi_inst_t *spiPort) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_portLockNums[spiIndex] < 0) { return ERROR_NOT_INITIALIZED; }
+        mySpinLock lock(_portLockNums[spiIndex]);
+        lock.lockBlocking();
+        if (_portOwners[spiIndex] != (int8_t)get_core_num()) {
+            lock.unlock();
+            return ERROR_NOT_OWNER;
+        }
+        _portDepths[spiIndex]--;
+        const bool freed = (_portDepths[spiIndex] == 0);
+        if (freed == true) { _portOwners[spiIndex] = -1; }
+        lock.unlock();
+        if (freed == true) { __resumePort__(spiIndex); }
+        return NO_ERROR;
+    }
+    /** @private */
+    bool __tryClaimPort__(spi_inst_t *spiPort, const int8_t owner) {
+    // Never waits, so an interrupt driven owner can take a free port:
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_portLockNums[spiIndex] < 0) { return false; }
+        mySpinLock lock(_portLockNums[spiIndex]);
+        lock.lockBlocking();
+        const bool claimed = (_portOwners[spiIndex] < 0);
+        if (claimed == true) {
+            _portOwners[spiIndex] = owner;
+            _portDepths[spiIndex] = 1;
+            _portStats[spiIndex].acquires++;
+        }
+        lock.unlock();
+        return claimed;
+    }
+    /** @private */
+    void __unclaimPort__(spi_inst_t *spiPort, const int8_t owner) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_portLockNums[spiIndex] < 0) { return; }
+        mySpinLock lock(_portLockNums[spiIndex]);
+        lock.lockBlocking();
+        const bool freed = (_portOwners[spiIndex] == owner);
+        if (freed == true) {
+            _portOwners[spiIndex] = -1;
+            _portDepths[spiIndex] = 0;
+        }
+        lock.unlock();
+    // The queue unclaims when it runs empty, with nothing to resume:
+        if (freed == true and owner != OWNER_QUEUE) { __resumePort__(spiIndex); }
+    }
+    /**
+     * @brief Get the owner of a port.
+     * @param spiPort SPI port instance.
+     * @return int8_t Core number owning the port, OWNER_QUEUE while a mySPIQueue runs on it,
+     * OWNER_TIMER during a timer poll, or -1 if free.
+     */
+    int8_t getPortOwner(spi_inst_t *spiPort) {
+        return _portOwners[spi_get_index(spiPort)];
+    }
+    /**
+     * @brief Get the contention counters of a port.
+     * @param spiPort SPI port instance.
+     * @return portStats_t Copy of the counters.
+     */
+    portStats_t getPortStats(spi_inst_t *spiPort) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_portLockNums[spiIndex] < 0) { return _portStats[spiIndex]; }
+        mySpinLock lock(_portLockNums[spiIndex]);
+        lock.lockBlocking();
+        const portStats_t stats = _portStats[spiIndex];
+        lock.unlock();
+        return stats;
+    }
+    /**
+     * @brief Clear the contention counters of a port.
+     * @param spiPort SPI port instance.
+     */
+    void resetPortStats(spi_inst_t *spiPort) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_portLockNums[spiIndex] < 0) { return; }
+        mySpinLock lock(_portLockNums[spiIndex]);
+        lock.lockBlocking();
+        _portStats[spiIndex] = portStats_t();
+        lock.unlock();
+    }
+#ifdef MY_SPI_STATS
+/*
+ * ######################### Stats functions: ######################
+ */
+    /**
+     * @brief Get the transfer counters of a port.
+     * Only available when MY_SPI_STATS is defined before including.
+     * @param spiPort SPI port instance.
+     * @return stats_t Snapshot of the counters.
+     */
+    stats_t getStats(spi_inst_t *spiPort) {
+        const uint32_t irqState = save_and_disable_interrupts();
+        const stats_t stats = _stats[spi_get_index(spiPort)];
+        restore_interrupts(irqState);
+        return stats;
+    }
+    /**
+     * @brief Clear the transfer counters of a port.
+     * Only available when MY_SPI_STATS is defined before including.
+     * @param spiPort SPI port instance.
+     */
+    void resetStats(spi_inst_t *spiPort) {
+        const uint32_t irqState = save_and_disable_interrupts();
+        _stats[spi_get_index(spiPort)] = stats_t();
+        restore_interrupts(irqState);
+    }
+#endif
+/*
+ * ######################### Private transfer functions: ######################
+ */
+#ifdef MY_SPI_STATS
+    /** @private */
+    struct __transferTimer__ {                  // Records a transfer call when it goes out of scope.
+        spi_inst_t *spiPort;
+        size_t bytes;
+        uint64_t startTime;
+        __transferTimer__(spi_inst_t *port, const size_t len) : spiPort (port), bytes (len) {
+            startTime = time_us_64();
+        }
+        ~__transferTimer__() {
+            const uint32_t elapsed = (uint32_t)(time_us_64() - startTime);
+            stats_t &stats = _stats[spi_get_index(spiPort)];
+            stats.bytes += bytes;
+            stats.transactions++;
+            stats.busyUs += elapsed;
+            if (elapsed > stats.maxLatencyUs) { stats.maxLatencyUs = elapsed; }
+        }
+    };
+    /** @private */
+    void __startPending__(spi_inst_t *spiPort, const size_t len) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        _dmaStartTimes[spiIndex] = time_us_64();
+        _dmaPendingBytes[spiIndex] = len;
+    }
+    /** @private */
+    void __finishPending__(spi_inst_t *spiPort) {  // Records a transfer left running once it's done.
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_dmaPendingBytes[spiIndex] == 0) { return; }
+        const uint32_t elapsed = (uint32_t)(time_us_64() - _dmaStartTimes[spiIndex]);
+        stats_t &stats = _stats[spiIndex];
+        stats.bytes += _dmaPendingBytes[spiIndex];
+        stats.transactions++;
+        stats.busyUs += elapsed;
+        if (elapsed > stats.maxLatencyUs) { stats.maxLatencyUs = elapsed; }
+        _dmaPendingBytes[spiIndex] = 0;
+    }
+#else
+    /** @private */
+    struct __transferTimer__ {                  // Compiles out.
+        __transferTimer__(spi_inst_t *port, const size_t len) {}
+    };
+    /** @private */
+    void inline __startPending__(spi_inst_t *spiPort, const size_t len) {}
+    /** @private */
+    void inline __finishPending__(spi_inst_t *spiPort) {}
+#endif
+    /** @private */
+    void inline __reverseBuffer__(uint8_t *dst, const uint8_t *src, size_t len) {
+        myHelpers::reverse8Buffer(dst, src, len);
+    }
+    /** @private */
+    void inline __reverseBuffer__(uint16_t *dst, const uint16_t *src, size_t len) {
+        myHelpers::reverse16Buffer(dst, src, len);
+    }
+    /** @private */
+    template <typename T>
+    constexpr dma_channel_transfer_size __dmaSize__() {
+        return (sizeof(T) == 2) ? DMA_SIZE_16 : DMA_SIZE_8;
+    }
+    /** @private */
+    template <typename T>
+    int __writeLsb__(spi_inst_t *spiPort, const T *src, size_t len) {
+        if (len == 0) { return 0; }
+        __transferTimer__ timer(spiPort, len * sizeof(T));
+        const size_t chunkSize = MY_SPI_DMA_CHUNK_SIZE / sizeof(T);
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        __claimDma__(spiPort);
+        uint8_t bufferIndex = 0;
+        size_t offset = 0;
+        size_t chunkLen = (len < chunkSize) ? len : chunkSize;
+        __reverseBuffer__((T *)_dmaBuffers[spiIndex][bufferIndex], src, chunkLen);
+        while (offset < len) {
+            __startDma__(spiPort, _dmaBuffers[spiIndex][bufferIndex], true, &_dmaSink, false, chunkLen,
+                            __dmaSize__<T>());
+        // Reverse the next chunk while this one transfers:
+            const size_t nextOffset = offset + chunkLen;
+            const size_t remaining = len - nextOffset;
+            const size_t nextLen = (remaining < chunkSize) ? remaining : chunkSize;
+            bufferIndex ^= 1;
+            __reverseBuffer__((T *)_dmaBuffers[spiIndex][bufferIndex], &src[nextOffset], nextLen);
+            __waitDma__(spiPort);
+            offset = nextOffset;
+            chunkLen = nextLen;
+        }
+        return (int)len;
+    }
+    /** @private */
+    template <typename T>
+    int __readLsb__(spi_inst_t *spiPort, const T repeatedData, T *dst, size_t len) {
+        if (len == 0) { return 0; }
+        __transferTimer__ timer(spiPort, len * sizeof(T));
+        const size_t chunkSize = MY_SPI_DMA_CHUNK_SIZE / sizeof(T);
+        __claimDma__(spiPort);
+        size_t offset = 0;
+        size_t lastOffset = 0;
+        size_t lastLen = 0;
+        while (offset < len) {
+            const size_t remaining = len - offset;
+            const size_t chunkLen = (remaining < chunkSize) ? remaining : chunkSize;
+            __startDma__(spiPort, &repeatedData, false, &dst[offset], true, chunkLen, __dmaSize__<T>());
+        // Reverse the previous chunk while this one transfers:
+            __reverseBuffer__(&dst[lastOffset], &dst[lastOffset], lastLen);
+            __waitDma__(spiPort);
+            lastOffset = offset;
+            lastLen = chunkLen;
+            offset += chunkLen;
+        }
+        __reverseBuffer__(&dst[lastOffset], &dst[lastOffset], lastLen);
+        return (int)len;
+    }
+    /** @private */
+    template <typename T>
+    int __writeReadLsb__(spi_inst_t *spiPort, const T *src, T *dst, size_t len) {
+        if (len == 0) { return 0; }
+        __transferTimer__ timer(spiPort, len * sizeof(T));
+        const size_t chunkSize = MY_SPI_DMA_CHUNK_SIZE / sizeof(T);
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        __claimDma__(spiPort);
+        uint8_t bufferIndex = 0;
+        size_t offset = 0;
+        size_t lastOffset = 0;
+        size_t lastLen = 0;
+        size_t chunkLen = (len < chunkSize) ? len : chunkSize;
+        __reverseBuffer__((T *)_dmaBuffers[spiIndex][bufferIndex], src, chunkLen);
+        while (offset < len) {
+            __startDma__(spiPort, _dmaBuffers[spiIndex][bufferIndex], true, &dst[offset], true, chunkLen,
+                            __dmaSize__<T>());
+        // Reverse the previous received chunk, and the next chunk to send while this one transfers:
+            __reverseBuffer__(&dst[lastOffset], &dst[lastOffset], lastLen);
+            const size_t nextOffset = offset + chunkLen;
+            const size_t remaining = len - nextOffset;
+            const size_t nextLen = (remaining < chunkSize) ? remaining : chunkSize;
+            bufferIndex ^= 1;
+            __reverseBuffer__((T *)_dmaBuffers[spiIndex][bufferIndex], &src[nextOffset], nextLen);
+            __waitDma__(spiPort);
+            lastOffset = offset;
+            lastLen = chunkLen;
+            offset = nextOffset;
+            chunkLen = nextLen;
+        }
+        __reverseBuffer__(&dst[lastOffset], &dst[lastOffset], lastLen);
+        return (int)len;
+    }
 /*
  * ######################### Transfer functions: ######################
  */
+    /**
+     * @brief Write blocking.
+     * spi_write_blocking, counted when MY_SPI_STATS is defined.
+     * @param spiPort SPI port instance.
+     * @param src Data to send.
+     * @param len Length of data in bytes.
+     * @return int Bytes written.
+     */
+    int write_blocking(spi_inst_t *spiPort, const uint8_t *src, size_t len) {
+        __transferTimer__ timer(spiPort, len);
+        return spi_write_blocking(spiPort, src, len);
+    }
+    /**
+     * @brief Read blocking.
+     * spi_read_blocking, counted when MY_SPI_STATS is defined.
+     * @param spiPort SPI port instance.
+     * @param repeatedData Data to send during transfer.
+     * @param dst Buffer for read data.
+     * @param len Length of buffer in bytes.
+     * @return int Bytes read.
+     */
+    int read_blocking(spi_inst_t *spiPort, const uint8_t repeatedData, uint8_t *dst, size_t len) {
+        __transferTimer__ timer(spiPort, len);
+        return spi_read_blocking(spiPort, repeatedData, dst, len);
+    }
+    /**
+     * @brief Read / write blocking.
+     * spi_write_read_blocking, counted when MY_SPI_STATS is defined.
+     * @param spiPort SPI port instance.
+     * @param src Buffer to send.
+     * @param dst Buffer to recieve.
+     * @param len Length of buffers in bytes.
+     * @return int Bytes transfered.
+     */
+    int write_read_blocking(spi_inst_t *spiPort, const uint8_t *src, uint8_t *dst, size_t len) {
+        __transferTimer__ timer(spiPort, len);
+        return spi_write_read_blocking(spiPort, src, dst, len);
+    }
+    /**
+     * @brief Write by DMA blocking.
+     * Sends bytes from src by DMA, transfers shorter than the FIFO go straight to the FIFO.
+     * @param spiPort SPI port instance.
+     * @param src Data to send.
+     * @param len Length of data in bytes.
+     * @return int Bytes written.
+     */
+    int write_dma_blocking(spi_inst_t *spiPort, const uint8_t *src, size_t len) {
+        if (len == 0) { return 0; }
+        __transferTimer__ timer(spiPort, len);
+        if (len < _FIFO_DEPTH) { return spi_write_blocking(spiPort, src, len); }
+        __claimDma__(spiPort);
+        __startDma__(spiPort, src, true, &_dmaSink, false, len);
+        __waitDma__(spiPort);
+        return (int)len;
+    }
+    /**
+     * @brief Read by DMA blocking.
+     * Reads bytes into dst by DMA, sending repeatedData. Transfers shorter than the FIFO go
+     * straight to the FIFO.
+     * @param spiPort SPI port instance.
+     * @param repeatedData Data to send during transfer.
+     * @param dst Buffer for read data.
+     * @param len Length of buffer in bytes.
+     * @return int Bytes read.
+     */
+    int read_dma_blocking(spi_inst_t *spiPort, const uint8_t repeatedData, uint8_t *dst, size_t len) {
+        if (len == 0) { return 0; }
+        __transferTimer__ timer(spiPort, len);
+        if (len < _FIFO_DEPTH) { return spi_read_blocking(spiPort, repeatedData, dst, len); }
+        __claimDma__(spiPort);
+        __startDma__(spiPort, &repeatedData, false, dst, true, len);
+        __waitDma__(spiPort);
+        return (int)len;
+    }
+    /**
+     * @brief Read / write by DMA blocking.
+     * Sends bytes from src, and reads bytes into dst by DMA. Transfers shorter than the FIFO go
+     * straight to the FIFO.
+     * @param spiPort SPI port instance.
+     * @param src Buffer to send.
+     * @param dst Buffer to recieve.
+     * @param len Length of buffers in bytes.
+     * @return int Bytes transfered.
+     */
+    int write_read_dma_blocking(spi_inst_t *spiPort, const uint8_t *src, uint8_t *dst, size_t len) {
+        if (len == 0) { return 0; }
+        __transferTimer__ timer(spiPort, len);
+        if (len < _FIFO_DEPTH) { return spi_write_read_blocking(spiPort, src, dst, len); }
+        __claimDma__(spiPort);
+        __startDma__(spiPort, src, true, dst, true, len);
+        __waitDma__(spiPort);
+        return (int)len;
+    }
+    /**
+     * @brief Start a write by DMA.
+     * Starts sending bytes from src by DMA and returns without waiting, src must stay valid until
+     * dma_is_busy() returns false or dma_wait() returns. Transfers shorter than the FIFO are sent
+     * blocking. Only one transfer per port may be left running.
+     * @param spiPort SPI port instance.
+     * @param src Data to send.
+     * @param len Length of data in bytes.
+     * @return int Bytes written or started.
+     */
+    int write_dma_start(spi_inst_t *spiPort, const uint8_t *src, size_t len) {
+        if (len < _FIFO_DEPTH) { return write_dma_blocking(spiPort, src, len); }
+        __claimDma__(spiPort);
+        __startPending__(spiPort, len);
+        __startDma__(spiPort, src, true, &_dmaSink, false, len);
+        return (int)len;
+    }
+    /**
+     * @brief Start a read by DMA.
+     * Starts reading bytes into dst by DMA, sending repeatedData, and returns without waiting. dst
+     * is filled once dma_is_busy() returns false or dma_wait() returns. Transfers shorter than the
+     * FIFO are read blocking. Only one transfer per port may be left running.
+     * @param spiPort SPI port instance.
+     * @param repeatedData Data to send during transfer.
+     * @param dst Buffer for read data.
+     * @param len Length of buffer in bytes.
+     * @return int Bytes read or started.
+     */
+    int read_dma_start(spi_inst_t *spiPort, const uint8_t repeatedData, uint8_t *dst, size_t len) {
+        if (len < _FIFO_DEPTH) { return read_dma_blocking(spiPort, repeatedData, dst, len); }
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        __claimDma__(spiPort);
+        __startPending__(spiPort, len);
+        _dmaRepeats[spiIndex] = repeatedData;
+        __startDma__(spiPort, &_dmaRepeats[spiIndex], false, dst, true, len);
+        return (int)len;
+    }
+    /**
+     * @brief Get a port's DMA channel.
+     * Claims the port's channels on first use. Both channels have sniffing enabled, so pointing
+     * the DMA sniffer at one checks the data it moves, tx for writes, rx for reads.
+     * @param spiPort SPI port instance.
+     * @param tx True for the transmit channel, false for the receive channel.
+     * @return int DMA channel number.
+     */
+    int get_dma_channel(spi_inst_t *spiPort, const bool tx) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        __claimDma__(spiPort);
+        return tx ? _dmaTxChannels[spiIndex] : _dmaRxChannels[spiIndex];
+    }
+    /**
+     * @brief Check for a DMA transfer still running.
+     * @param spiPort SPI port instance.
+     * @return true A transfer started by write_dma_start() or read_dma_start() is running.
+     * @return false The port's DMA is idle.
+     */
+    bool dma_is_busy(spi_inst_t *spiPort) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_dmaRxChannels[spiIndex] < 0) { return false; }
+        if (dma_channel_is_busy(_dmaRxChannels[spiIndex]) == true) { return true; }
+        __finishPending__(spiPort);
+        return false;
+    }
+    /**
+     * @brief Wait for a DMA transfer to finish.
+     * Returns at once if the port's DMA is idle.
+     * @param spiPort SPI port instance.
+     */
+    void dma_wait(spi_inst_t *spiPort) {
+        const uint8_t spiIndex = spi_get_index(spiPort);
+        if (_dmaRxChannels[spiIndex] < 0) { return; }
+        __waitDma__(spiPort);
+        __finishPending__(spiPort);
+    }
     /**
      * @brief Write LSB first blocking.
-     * Reverses the bit order of the data, and sends via spi.
+     * Reverses the bit order of the data, and sends via spi. The data is reversed into a staging
+     * buffer and sent by DMA in chunks of MY_SPI_DMA_CHUNK_SIZE bytes, the next chunk is reversed
+     * while the current one is on the wire.
      * @param spiPort SPI port instance.
      * @param src Data to send.
      * @param len Length of data in bytes.
      * @return int Bytes written.
      */
     int write_lsb_blocking(spi_inst_t *spiPort, const uint8_t *src, size_t len) {
-        int bytes = 0;
-        uint8_t reversedByte;
-        for (size_t i=0; i<len; i++) {
-            reversedByte = myHelpers::reverse8(src[i]);
-            spi_write_blocking(spiPort, &reversedByte, 1);
-            bytes++;
-        }
-        return bytes;
+        return __writeLsb__<uint8_t>(spiPort, src, len);
     }
     /**
      * @brief Read LSB first blocking.
-     * Reads data from SPI and reverses the bit order.
+     * Reads data from SPI and reverses the bit order. Data is read by DMA directly into dst in
+     * chunks of MY_SPI_DMA_CHUNK_SIZE bytes, each chunk is reversed while the next one transfers.
      * @param spiPort SPI port instance.
      * @param repeatedData Data to send during transfer.
      * @param dst Buffer for read data.
@@ -360,18 +1232,13 @@ namespace mySPI {
      * @return int Bytes read.
      */
     int read_lsb_blocking(spi_inst_t *spiPort, uint8_t repeatedData, uint8_t *dst, size_t len) {
-        int bytes = 0;
-        uint8_t receivedByte = 0;
-        for (size_t i=0; i<len; i++) {
-            spi_read_blocking(spiPort, repeatedData, &receivedByte, 1);
-            dst[i] = myHelpers::reverse8(receivedByte);
-            bytes++;
-        }
-        return bytes;
+        return __readLsb__<uint8_t>(spiPort, repeatedData, dst, len);
     }
     /**
      * @brief Read / write LSB first blocking.
-     * Transfers a buffer, and reverses the data so it's sent lsb first.
+     * Transfers a buffer, and reverses the data so it's sent lsb first. Outgoing data is reversed
+     * into a staging buffer, incoming data is read by DMA directly into dst, both are reversed
+     * while the current chunk transfers.
      * @param spiPort SPI port instance.
      * @param src Buffer to send.
      * @param dst Buffer to recieve.
@@ -379,74 +1246,104 @@ namespace mySPI {
      * @return int Number of bytes transfered.
      */
     int write_read_lsb_blocking(spi_inst_t *spiPort, const uint8_t *src, uint8_t *dst, size_t len) {
-        int bytes = 0;
-        uint8_t reversedByte;
-        uint8_t recievedByte;
-        for (size_t i=0; i<len; i++) {
-            reversedByte = myHelpers::reverse8(src[i]);
-            spi_write_read_blocking(spiPort, &reversedByte, &recievedByte, 1);
-            dst[i] = myHelpers::reverse8(recievedByte);
-            bytes++;
-        }
-        return bytes;
+        return __writeReadLsb__<uint8_t>(spiPort, src, dst, len);
+    }
+/*
+ * ######################### 16 bit frame functions: ######################
+ * These need the port in 16 bit frame mode, IE: a profile with dataBits = 16 selected. Each half
+ * word is one FIFO entry, and is moved by DMA as a half word.
+ */
+    /**
+     * @brief Write 16 bit frames blocking.
+     * Sends half words from src by DMA, transfers shorter than the FIFO go straight to the FIFO.
+     * @param spiPort SPI port instance, in 16 bit frame mode.
+     * @param src Data to send.
+     * @param len Length of data in half words.
+     * @return int Number of half words written.
+     */
+    int write16_blocking(spi_inst_t *spiPort, const uint16_t *src, size_t len) {
+        if (len == 0) { return 0; }
+        __transferTimer__ timer(spiPort, len * 2);
+        if (len < _FIFO_DEPTH) { return spi_write16_blocking(spiPort, src, len); }
+        __claimDma__(spiPort);
+        __startDma__(spiPort, src, true, &_dmaSink, false, len, DMA_SIZE_16);
+        __waitDma__(spiPort);
+        return (int)len;
+    }
+    /**
+     * @brief Read 16 bit frames blocking.
+     * Reads half words into dst by DMA, sending repeatedData. Transfers shorter than the FIFO go
+     * straight to the FIFO.
+     * @param spiPort SPI port instance, in 16 bit frame mode.
+     * @param repeatedData Data to send during transfer.
+     * @param dst Buffer for read data.
+     * @param len Length of buffer in half words.
+     * @return int Number of half words read.
+     */
+    int read16_blocking(spi_inst_t *spiPort, const uint16_t repeatedData, uint16_t *dst, size_t len) {
+        if (len == 0) { return 0; }
+        __transferTimer__ timer(spiPort, len * 2);
+        if (len < _FIFO_DEPTH) { return spi_read16_blocking(spiPort, repeatedData, dst, len); }
+        __claimDma__(spiPort);
+        __startDma__(spiPort, &repeatedData, false, dst, true, len, DMA_SIZE_16);
+        __waitDma__(spiPort);
+        return (int)len;
+    }
+    /**
+     * @brief Transfer 16 bit frames blocking.
+     * Sends half words from src, and reads half words into dst by DMA. Transfers shorter than the
+     * FIFO go straight to the FIFO.
+     * @param spiPort SPI port instance, in 16 bit frame mode.
+     * @param src Buffer to send.
+     * @param dst Buffer to recieve.
+     * @param len Length of buffers in half words.
+     * @return int Number of half words transfered.
+     */
+    int write16_read16_blocking(spi_inst_t *spiPort, const uint16_t *src, uint16_t *dst, size_t len) {
+        if (len == 0) { return 0; }
+        __transferTimer__ timer(spiPort, len * 2);
+        if (len < _FIFO_DEPTH) { return spi_write16_read16_blocking(spiPort, src, dst, len); }
+        __claimDma__(spiPort);
+        __startDma__(spiPort, src, true, dst, true, len, DMA_SIZE_16);
+        __waitDma__(spiPort);
+        return (int)len;
     }
     /**
      * @brief Write 16 lsb blocking.
-     * Write a 16bit word LSB first to SPI. 
-     * @param spiPort SPI port instance
+     * Write 16 bit words LSB first to SPI. Words are reversed into a staging buffer and sent by DMA
+     * as half words, the next chunk is reversed while the current one is on the wire.
+     * @param spiPort SPI port instance, in 16 bit frame mode.
      * @param src Data to write.
-     * @param len Length of buffer in half words (bytes).
-     * @return int Number of half words transfered (bytes).
+     * @param len Length of buffer in bytes, an odd last byte isn't sent.
+     * @return int Number of bytes transfered.
      */
     int write16_lsb_blocking(spi_inst_t *spiPort, const uint16_t *src, size_t len) {
-        int bytes = 0;
-        uint16_t reversedWord;
-        for (size_t i=0; i<(len/2); i++) {
-            reversedWord = myHelpers::reverse16(src[i]);
-            spi_write16_blocking(spiPort, &reversedWord, 2);
-            bytes += 2;
-        }
-        return bytes;
+        return __writeLsb__<uint16_t>(spiPort, src, len / 2) * 2;
     }
     /**
      * @brief Read 16 LSB first.
-     * Read a 16 bit word from SPI and reverse the data so it's LSB first.
-     * @param spiPort SPI port instance.
+     * Read 16 bit words from SPI and reverse the data so it's LSB first. Words are read by DMA as half
+     * words directly into dst, each chunk is reversed while the next one transfers.
+     * @param spiPort SPI port instance, in 16 bit frame mode.
      * @param repeatedData Data to repeat when transfering.
      * @param dst Buffer for recieved data.
-     * @param len Length of buffer in half words (bytes).
-     * @return int Returns Number of half words read (bytes).
+     * @param len Length of buffer in bytes, an odd last byte isn't read.
+     * @return int Returns Number of bytes read.
      */
     int read16_lsb_blocking(spi_inst_t *spiPort, uint16_t repeatedData, uint16_t *dst, size_t len) {
-        int bytes = 0;
-        uint16_t recievedData;
-        for (size_t i=0; i<(len/2); i++) {
-            spi_read16_blocking(spiPort, repeatedData, &recievedData, 2);
-            dst[i] = myHelpers::reverse16(recievedData);
-            bytes += 2;
-        }
-        return bytes;
+        return __readLsb__<uint16_t>(spiPort, repeatedData, dst, len / 2) * 2;
     }
     /**
      * @brief Transfer 16 bit words LSB first.
      * Transfer 16 bit words, reversing the data so it's LSB first.
-     * @param spiPort SPI port instance.
+     * @param spiPort SPI port instance, in 16 bit frame mode.
      * @param src Buffer to send.
      * @param dst Buffer to recieve.
-     * @param len Length of buffer in half words(bytes).
-     * @return int Number of half words transfered (bytes).
+     * @param len Length of buffers in bytes, an odd last byte isn't transfered.
+     * @return int Number of bytes transfered.
      */
     int write16_read16_lsb_blocking(spi_inst_t *spiPort, const uint16_t *src, uint16_t *dst, size_t len) {
-        int bytes = 0;
-        uint16_t reversedWord;
-        uint16_t recievedWord;
-        for (size_t i=0; i<(len/2); i++) {
-            reversedWord = myHelpers::reverse16(src[i]);
-            spi_write16_read16_blocking(spiPort, &reversedWord, &recievedWord, 2);
-            dst[i] = myHelpers::reverse16(recievedWord);
-            bytes += 2;
-        }
-        return bytes;
+        return __writeReadLsb__<uint16_t>(spiPort, src, dst, len / 2) * 2;
     }
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,293 @@
+/**
+ * @file mySPIQueue.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief Queued, DMA driven SPI transactions.
+ * @version 0.1
+ * @date 2022-08-02
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY_SPI_QUEUE_H
+#define MY_SPI_QUEUE_H
+
+#include <hardware/gpio.h>
+#include <hardware/spi.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
+
+#include "../myStandardDefines.hpp"
+#include "../myErrorCodes.hpp"
+#include "../myHelpers.hpp"
+#include "../mySPI/mySPI.hpp"
+/**
+ * @brief Queued, DMA driven SPI transactions.
+ * Runs transactions on a SPI port in the background. Each transaction asserts its chip select,
+ * transfers its buffers by DMA, deasserts the chip select, and calls its callback. The next
+ * queued transaction is started from the DMA interrupt, before the callback is called, so the
+ * bus stays busy while the application prepares more work. The queue owns the port, as
+ * mySPI::OWNER_QUEUE, from its first transaction until it runs empty, so mySPI::acquirePort()
+ * waits for it. If a core owns the port when work is submitted, the queue waits in turn, and starts
+ * from mySPI::releasePort() when the port is freed.
+ * @note Callbacks are called from the DMA_IRQ_0 interrupt.
+ */
+class mySPIQueue {
+
+    public:
+/* ################### Types: ##################### */
+        /**
+         * @brief Transaction complete callback.
+         * Called from interrupt context with the result of the transaction, and the user data.
+         */
+        typedef void (*callback_t)(const int16_t status, void *userData);
+        /**
+         * @brief Transaction descriptor.
+         * The buffers must stay valid until the callback is called.
+         */
+        struct transaction_t {
+            uint8_t csPin = MY_NOT_A_PIN;           // Chip select pin, active low. MY_NOT_A_PIN for none.
+            int16_t profileId = -1;                 // 8 bit mySPI profile selected before cs, -1 keeps the port's settings.
+            const uint8_t *txBuffer = nullptr;      // Data to send, nullptr sends repeatedData.
+            uint8_t *rxBuffer = nullptr;            // Buffer for received data, nullptr discards it.
+            size_t length = 0;                      // Number of bytes to transfer.
+            uint8_t repeatedData = 0x00;            // Data sent when txBuffer is nullptr.
+            callback_t callback = nullptr;          // Called on completion, may be nullptr.
+            void *userData = nullptr;               // Passed to the callback.
+        };
+/* ################### Constants: ################# */
+        /**
+         * @brief Number of transactions the queue holds.
+         */
+        static const uint8_t QUEUE_LENGTH = MY_SPI_QUEUE_LENGTH;
+    // Error codes:
+        /**
+         * @brief No error. Value 0.
+         * No error occured.
+         */
+        static const int16_t NO_ERROR = MY_NO_ERROR;
+        /**
+         * @brief Value error. Value -9.
+         * The transaction length is zero, or its profile isn't an 8 bit profile on this port.
+         */
+        static const int16_t ERROR_VALUE = MY_VALUE_ERROR;
+        /**
+         * @brief SPI port not initialized. Value -155.
+         * The SPI port, or the queue, is not initialized.
+         */
+        static const int16_t ERROR_NOT_INITIALIZED = MY_ERROR_SPI_NOT_INITIALIZED;
+        /**
+         * @brief Queue already initialized. Value -154.
+         * The queue was already initialized when initialize was called.
+         */
+        static const int16_t ERROR_INITIALIZED = MY_ERROR_SPI_INITIALIZED;
+        /**
+         * @brief Queue full. Value -156.
+         * The queue was full when a transaction was submitted.
+         */
+        static const int16_t ERROR_QUEUE_FULL = MY_ERROR_SPI_QUEUE_FULL;
+/* ################## Constructor: ################ */
+        /**
+         * @brief Construct a new mySPIQueue object.
+         * @param spiPort SPI port instance to run transactions on. Must be initialized as master.
+         */
+        mySPIQueue(spi_inst_t *spiPort) {
+            _spiPort = spiPort;
+        }
+/* ################ Public functions: ############## */
+        /**
+         * @brief Initialize the queue.
+         * Claims a pair of DMA channels and installs the shared DMA_IRQ_0 handler. Returns 0 (NO_ERROR)
+         * on success, otherwise if the port isn't initialized, or another queue is already running on
+         * the port, an error code is returned.
+         * @return int16_t Returns 0 (NO_ERROR) if initialized okay, negative for error code.
+         */
+        int16_t initialize();
+        /**
+         * @brief Deinitialize the queue.
+         * Waits for queued transactions to complete, then releases the DMA channels and the spin
+         * lock.
+         * @return int16_t Returns 0 (NO_ERROR) if deinitialized okay, negative for error code.
+         */
+        int16_t deinitialize();
+        /**
+         * @brief Submit a transaction.
+         * Copies the descriptor into the queue and returns immediately. If the bus is idle the
+         * transaction is started straight away. Safe to call from either core, and from a callback.
+         * @param transaction Transaction to queue.
+         * @return int16_t Returns 0 (NO_ERROR) if queued, negative for error code.
+         */
+        int16_t submit(const transaction_t &transaction);
+        /**
+         * @brief Check if the queue is idle.
+         * @return true No transaction in progress or queued.
+         * @return false A transaction is in progress.
+         */
+        bool isIdle();
+        /**
+         * @brief Get the number of pending transactions.
+         * @return uint8_t Number of transactions queued, including the one in progress.
+         */
+        uint8_t getPending();
+        /**
+         * @brief Block until the queue is idle.
+         */
+        void waitIdle();
+
+    private:
+/* ################ Private variables: ############### */
+        static mySPIQueue *_instances[MY_SPI_NUM_PORTS];   // Queues by port, for the irq handler.
+        spi_inst_t *_spiPort;
+        int _txChannel = -1;
+        int _rxChannel = -1;
+        spin_lock_t *_lock = nullptr;                       // Guards the queue between cores and the irq.
+        transaction_t _queue[QUEUE_LENGTH];
+        volatile uint8_t _head = 0;                         // Next free slot.
+        volatile uint8_t _tail = 0;                         // Transaction in progress.
+        volatile uint8_t _count = 0;                        // Number of queued transactions.
+        volatile bool _running = false;                     // Transaction at _tail in progress.
+        bool _ownsPort = false;                             // Port held as mySPI::OWNER_QUEUE.
+        uint8_t _sink;                                      // Discarded rx data.
+        bool _initialized = false;
+/* ################ Private functions: ############### */
+        static void __irqHandler__();
+        void __start__();                                   // Start the transaction at _tail if the port is ours, lock held.
+        void __resume__();                                  // Start a transaction left waiting for the port.
+        static void __portFreed__(void *userData);          // mySPI port resume hook.
+        void __complete__();                                // Finish the current transaction, start the next.
+};
+
+mySPIQueue *mySPIQueue::_instances[MY_SPI_NUM_PORTS] = { nullptr, nullptr };
+
+/* ################## Public functions: ################## */
+int16_t mySPIQueue::initialize() {
+    if (_initialized == true) { return ERROR_INITIALIZED; }
+    if (mySPI::getPortInit(_spiPort) == false) { return ERROR_NOT_INITIALIZED; }
+    const uint8_t spiIndex = spi_get_index(_spiPort);
+    if (_instances[spiIndex] != nullptr) { return ERROR_INITIALIZED; }
+    _lock = spin_lock_init(spin_lock_claim_unused(true));
+    _txChannel = dma_claim_unused_channel(true);
+    _rxChannel = dma_claim_unused_channel(true);
+    _instances[spiIndex] = this;
+    mySPI::__setPortResume__(_spiPort, __portFreed__, this);
+    irq_add_shared_handler(DMA_IRQ_0, __irqHandler__, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    dma_channel_set_irq0_enabled(_rxChannel, true);
+    irq_set_enabled(DMA_IRQ_0, true);
+    _initialized = true;
+    return NO_ERROR;
+}
+
+int16_t mySPIQueue::deinitialize() {
+    if (_initialized == false) { return ERROR_NOT_INITIALIZED; }
+    waitIdle();
+    dma_channel_set_irq0_enabled(_rxChannel, false);
+    irq_remove_handler(DMA_IRQ_0, __irqHandler__);
+    dma_channel_unclaim(_txChannel);
+    dma_channel_unclaim(_rxChannel);
+    spin_lock_unclaim(spin_lock_get_num(_lock));
+    _txChannel = -1;
+    _rxChannel = -1;
+    _lock = nullptr;
+    mySPI::__setPortResume__(_spiPort, nullptr, nullptr);
+    _instances[spi_get_index(_spiPort)] = nullptr;
+    _initialized = false;
+    return NO_ERROR;
+}
+
+int16_t mySPIQueue::submit(const transaction_t &transaction) {
+    if (_initialized == false) { return ERROR_NOT_INITIALIZED; }
+    if (transaction.length == 0) { return ERROR_VALUE; }
+    if (transaction.profileId >= 0) {
+    // The DMA moves bytes, so only 8 bit frames:
+        if (transaction.profileId >= mySPI::_numProfiles) { return ERROR_VALUE; }
+        if (mySPI::_profilePorts[transaction.profileId] != spi_get_index(_spiPort)) { return ERROR_VALUE; }
+        if (mySPI::_profiles[transaction.profileId].dataBits != 8) { return ERROR_VALUE; }
+    }
+    uint32_t irqState = spin_lock_blocking(_lock);
+    if (_count == QUEUE_LENGTH) {
+        spin_unlock(_lock, irqState);
+        return ERROR_QUEUE_FULL;
+    }
+    _queue[_head] = transaction;
+    _head = (_head + 1) % QUEUE_LENGTH;
+    _count++;
+    if (_running == false) { __start__(); }         // Bus was idle.
+    spin_unlock(_lock, irqState);
+    return NO_ERROR;
+}
+
+bool mySPIQueue::isIdle() {
+    __resume__();
+    return (_count == 0);
+}
+
+uint8_t mySPIQueue::getPending() {
+    __resume__();
+    return _count;
+}
+
+void mySPIQueue::waitIdle() {
+    while (_count > 0) {
+        __resume__();
+        tight_loop_contents();
+    }
+}
+
+/* ################## Private functions: ################# */
+void mySPIQueue::__irqHandler__() {
+    for (uint8_t i=0; i<MY_SPI_NUM_PORTS; i++) {
+        mySPIQueue *queue = _instances[i];
+        if (queue == nullptr) { continue; }
+        if (dma_channel_get_irq0_status(queue->_rxChannel) == true) {
+            dma_channel_acknowledge_irq0(queue->_rxChannel);
+            queue->__complete__();
+        }
+    }
+}
+
+void mySPIQueue::__start__() {
+    if (_count == 0) {
+    // Ran empty, hand the port back:
+        if (_ownsPort == true) { mySPI::__unclaimPort__(_spiPort, mySPI::OWNER_QUEUE); }
+        _ownsPort = false;
+        return;
+    }
+    if (_ownsPort == false) {
+        _ownsPort = mySPI::__tryClaimPort__(_spiPort, mySPI::OWNER_QUEUE);
+        if (_ownsPort == false) { return; }         // A core owns it, resumed later.
+    }
+    transaction_t &transaction = _queue[_tail];
+    const bool haveTx = (transaction.txBuffer != nullptr);
+    const bool haveRx = (transaction.rxBuffer != nullptr);
+    if (transaction.profileId >= 0) { mySPI::selectProfile(_spiPort, transaction.profileId); }
+    if (myHelpers::isPin(transaction.csPin) == true) { gpio_put(transaction.csPin, false); }
+    _running = true;
+    mySPI::__configureDma__(_spiPort, _txChannel, _rxChannel,
+                            haveTx ? transaction.txBuffer : &transaction.repeatedData, haveTx,
+                            haveRx ? transaction.rxBuffer : &_sink, haveRx, transaction.length);
+}
+
+void mySPIQueue::__resume__() {
+    if (_initialized == false or _running == true or _count == 0) { return; }
+    uint32_t irqState = spin_lock_blocking(_lock);
+    if (_running == false) { __start__(); }
+    spin_unlock(_lock, irqState);
+}
+
+void mySPIQueue::__portFreed__(void *userData) {
+    ((mySPIQueue *)userData)->__resume__();
+}
+
+void mySPIQueue::__complete__() {
+    const transaction_t done = _queue[_tail];
+    if (myHelpers::isPin(done.csPin) == true) { gpio_put(done.csPin, true); }
+    uint32_t irqState = spin_lock_blocking(_lock);
+    _tail = (_tail + 1) % QUEUE_LENGTH;
+    _count--;
+    _running = false;
+    __start__();
+    spin_unlock(_lock, irqState);
+// Callback last, so it can submit more work:
+    if (done.callback != nullptr) { done.callback(NO_ERROR, done.userData); }
+}
+#endif
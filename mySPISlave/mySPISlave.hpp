@@ -0,0 +1,381 @@
+/**
+ * @file mySPISlave.hpp
+ * @author Peter Nearing (pnearing@protonmail.com)
+ * @brief DMA driven SPI slave data path.
+ * @version 0.1
+ * @date 2022-08-04
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#ifndef MY_SPI_SLAVE_H
+#define MY_SPI_SLAVE_H
+
+#include <hardware/gpio.h>
+#include <hardware/spi.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
+
+#include "../myStandardDefines.hpp"
+#include "../myErrorCodes.hpp"
+#include "../myHelpers.hpp"
+#include "../mySPI/mySPI.hpp"
+/**
+ * @brief DMA driven SPI slave data path.
+ * Receives continuously by DMA into a ring buffer, and transmits from a buffer loaded ahead of
+ * time, on a port initialized with mySPI::initializeSlave(). The rising edge of the chip select
+ * pin ends a frame, completed frames are queued and read back as views into the ring, without
+ * copying.
+ * @note The ring can't apply back pressure to the master. A frame not released before the ring
+ * wraps onto it is overwritten, and reported as an overrun.
+ * @note The ring is aligned to its size for the DMA ring wrap, declare instances globally or static.
+ */
+class mySPISlave {
+
+    public:
+/* ################### Types: ##################### */
+        /**
+         * @brief View of a received frame.
+         * A frame that wraps around the end of the ring is split into two segments, otherwise
+         * wrapLength is 0. The data belongs to the ring, and is valid until releaseFrame().
+         */
+        struct frame_t {
+            const uint8_t *data = nullptr;          // First segment.
+            size_t length = 0;                      // Length of the first segment.
+            const uint8_t *wrapData = nullptr;      // Second segment, from the start of the ring.
+            size_t wrapLength = 0;                  // Length of the second segment.
+        };
+/* ################### Constants: ################# */
+        /**
+         * @brief Size of the receive ring in bytes.
+         */
+        static const size_t RING_SIZE = (1u << MY_SPI_SLAVE_RING_BITS);
+        /**
+         * @brief Number of completed frames held.
+         */
+        static const uint8_t MAX_FRAMES = MY_SPI_SLAVE_MAX_FRAMES;
+    // Error codes:
+        /**
+         * @brief No error. Value 0.
+         * No error occured.
+         */
+        static const int16_t NO_ERROR = MY_NO_ERROR;
+        /**
+         * @brief Value error. Value -9.
+         * The transmit length is zero.
+         */
+        static const int16_t ERROR_VALUE = MY_VALUE_ERROR;
+        /**
+         * @brief SPI port not initialized. Value -155.
+         * The SPI port is not initialized as a slave, or the data path is not initialized.
+         */
+        static const int16_t ERROR_NOT_INITIALIZED = MY_ERROR_SPI_NOT_INITIALIZED;
+        /**
+         * @brief Already initialized. Value -154.
+         * The data path was already initialized when initialize was called.
+         */
+        static const int16_t ERROR_INITIALIZED = MY_ERROR_SPI_INITIALIZED;
+        /**
+         * @brief Invalid chip select pin. Value -153.
+         * The port was initialized without a chip select pin.
+         */
+        static const int16_t ERROR_INVALID_CS_PIN = MY_ERROR_SPI_INVALID_CS_PIN;
+        /**
+         * @brief Transmit queue full. Value -156.
+         * A transmit buffer is already loaded, and waiting for the next frame.
+         */
+        static const int16_t ERROR_QUEUE_FULL = MY_ERROR_SPI_QUEUE_FULL;
+        /**
+         * @brief No frame. Value -159.
+         * No completed frame is waiting.
+         */
+        static const int16_t ERROR_NO_FRAME = MY_ERROR_SPI_NO_FRAME;
+        /**
+         * @brief Overrun. Value -160.
+         * The frame was overwritten by newer data before it was released.
+         */
+        static const int16_t ERROR_OVERRUN = MY_ERROR_SPI_OVERRUN;
+/* ################## Constructor: ################ */
+        /**
+         * @brief Construct a new mySPISlave object.
+         * @param spiPort SPI port instance. Must be initialized as slave, with a chip select pin.
+         */
+        mySPISlave(spi_inst_t *spiPort) {
+            _spiPort = spiPort;
+        }
+/* ################ Public functions: ############## */
+        /**
+         * @brief Initialize the data path.
+         * Sets the frame format, claims a pair of DMA channels, starts receiving into the ring, and
+         * enables the chip select rising edge interrupt.
+         * @note With CPHA 0 the SPI peripheral needs chip select raised between every byte, so a
+         * master holding chip select low for a whole frame needs CPHA 1, which is the default.
+         * @param cpol Clock polarity.
+         * @param cpha Clock phase.
+         * @return int16_t Returns 0 (NO_ERROR) if initialized okay, negative for error code.
+         */
+        int16_t initialize(const spi_cpol_t cpol=SPI_CPOL_0, const spi_cpha_t cpha=SPI_CPHA_1);
+        /**
+         * @brief Deinitialize the data path.
+         * Stops both DMA channels, disables the chip select interrupt, and drops any queued frames.
+         * @return int16_t Returns 0 (NO_ERROR) if deinitialized okay, negative for error code.
+         */
+        int16_t deinitialize();
+        /**
+         * @brief Load data to transmit.
+         * If chip select is high and nothing is being sent, the data is fed to the transmit FIFO
+         * straight away, ready for the next frame. Otherwise it's held, and loaded when the current
+         * frame ends. The buffer must stay valid until the frame it's sent in has ended.
+         * @note If the master clocks fewer bytes than loaded, up to 8 bytes left in the transmit FIFO
+         * lead the following frame.
+         * @param src Data to send.
+         * @param len Length of data in bytes.
+         * @return int16_t Returns 0 (NO_ERROR) if loaded, negative for error code.
+         */
+        int16_t loadTx(const uint8_t *src, const size_t len);
+        /**
+         * @brief Get the number of completed frames waiting.
+         * @return uint8_t Number of frames.
+         */
+        uint8_t getFrameCount();
+        /**
+         * @brief Get the oldest completed frame.
+         * Fills frame with a view of the oldest frame still intact in the ring. Frames already
+         * overwritten are dropped, and counted as overruns. The frame stays queued until released.
+         * @param frame View to fill.
+         * @return int16_t Returns 0 (NO_ERROR) if a frame was returned, negative for error code.
+         */
+        int16_t getFrame(frame_t &frame);
+        /**
+         * @brief Release the oldest frame.
+         * Drops the frame returned by getFrame(). Returns ERROR_OVERRUN if it was overwritten while
+         * it was held, in which case the view held stale data.
+         * @return int16_t Returns 0 (NO_ERROR) if released okay, negative for error code.
+         */
+        int16_t releaseFrame();
+        /**
+         * @brief Get the number of overruns.
+         * Number of frames dropped because they were overwritten, or the frame queue was full.
+         * @return uint32_t Number of overruns.
+         */
+        uint32_t getOverruns();
+
+    private:
+/* ################ Private constants: ############### */
+        static const uint32_t _RING_MASK = RING_SIZE - 1;
+        static const uint32_t _ARM_COUNT = 0xFFFFFFFF;              // Rx transfer count, re-armed at half.
+/* ################ Private types: ############### */
+        struct __frameDesc__ {
+            uint32_t start;                                         // Received byte count at frame start.
+            uint32_t length;
+        };
+/* ################ Private variables: ############### */
+        static mySPISlave *_instances[MY_SPI_NUM_PORTS];            // Slaves by port, for the irq handler.
+        uint8_t _ring[RING_SIZE] __attribute__((aligned(RING_SIZE)));
+        spi_inst_t *_spiPort;
+        uint8_t _csPin = MY_NOT_A_PIN;
+        int _txChannel = -1;
+        int _rxChannel = -1;
+        spin_lock_t *_lock = nullptr;                               // Guards the frame queue between cores and the irq.
+        __frameDesc__ _frames[MAX_FRAMES];
+        volatile uint8_t _head = 0;                                 // Next free slot.
+        volatile uint8_t _tail = 0;                                 // Oldest frame.
+        volatile uint8_t _count = 0;
+        uint32_t _rxBase = 0;                                       // Received byte count when rx was armed.
+        uint32_t _frameStart = 0;                                   // Received byte count at current frame start.
+        const uint8_t *volatile _txPending = nullptr;
+        size_t _txPendingLen = 0;
+        volatile uint32_t _overruns = 0;
+        bool _initialized = false;
+/* ################ Private functions: ############### */
+        static void __csIrqHandler__();
+        uint32_t __received__();                                    // Total bytes received, wrapping.
+        void __armRx__(const uint32_t received);                   // (Re)start rx, bus idle.
+        void __startTx__(const uint8_t *src, const size_t len);
+        void __frameEnd__();                                        // Queue the frame, swap tx buffers.
+};
+
+mySPISlave *mySPISlave::_instances[MY_SPI_NUM_PORTS] = { nullptr, nullptr };
+
+/* ################## Public functions: ################## */
+int16_t mySPISlave::initialize(const spi_cpol_t cpol, const spi_cpha_t cpha) {
+    if (_initialized == true) { return ERROR_INITIALIZED; }
+    if (mySPI::getPortInit(_spiPort) == false or mySPI::isMaster(_spiPort) == true) {
+        return ERROR_NOT_INITIALIZED;
+    }
+    _csPin = mySPI::getChipSelectPin(_spiPort);
+    if (myHelpers::isPin(_csPin) == false) { return ERROR_INVALID_CS_PIN; }
+    const uint8_t spiIndex = spi_get_index(_spiPort);
+    if (_instances[spiIndex] != nullptr) { return ERROR_INITIALIZED; }
+    spi_set_format(_spiPort, 8, cpol, cpha, SPI_MSB_FIRST);
+    _lock = spin_lock_init(spin_lock_claim_unused(true));
+    _txChannel = dma_claim_unused_channel(true);
+    _rxChannel = dma_claim_unused_channel(true);
+    _head = 0;
+    _tail = 0;
+    _count = 0;
+    _frameStart = 0;
+    _txPending = nullptr;
+    __armRx__(0);
+    _instances[spiIndex] = this;
+    gpio_add_raw_irq_handler(_csPin, __csIrqHandler__);
+    gpio_set_irq_enabled(_csPin, GPIO_IRQ_EDGE_RISE, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+    _initialized = true;
+    return NO_ERROR;
+}
+
+int16_t mySPISlave::deinitialize() {
+    if (_initialized == false) { return ERROR_NOT_INITIALIZED; }
+    gpio_set_irq_enabled(_csPin, GPIO_IRQ_EDGE_RISE, false);
+    gpio_remove_raw_irq_handler(_csPin, __csIrqHandler__);
+    dma_channel_abort(_txChannel);
+    dma_channel_abort(_rxChannel);
+    dma_channel_unclaim(_txChannel);
+    dma_channel_unclaim(_rxChannel);
+    spin_lock_unclaim(spin_lock_get_num(_lock));
+    _txChannel = -1;
+    _rxChannel = -1;
+    _count = 0;
+    _instances[spi_get_index(_spiPort)] = nullptr;
+    _initialized = false;
+    return NO_ERROR;
+}
+
+int16_t mySPISlave::loadTx(const uint8_t *src, const size_t len) {
+    if (_initialized == false) { return ERROR_NOT_INITIALIZED; }
+    if (len == 0) { return ERROR_VALUE; }
+    uint32_t irqState = spin_lock_blocking(_lock);
+    if (_txPending != nullptr) {
+        spin_unlock(_lock, irqState);
+        return ERROR_QUEUE_FULL;
+    }
+    if (gpio_get(_csPin) == true and dma_channel_is_busy(_txChannel) == false) {
+        __startTx__(src, len);
+    } else {
+        _txPendingLen = len;
+        _txPending = src;
+    }
+    spin_unlock(_lock, irqState);
+    return NO_ERROR;
+}
+
+uint8_t mySPISlave::getFrameCount() {
+    return _count;
+}
+
+int16_t mySPISlave::getFrame(frame_t &frame) {
+    if (_initialized == false) { return ERROR_NOT_INITIALIZED; }
+    uint32_t irqState = spin_lock_blocking(_lock);
+    const uint32_t received = __received__();
+// Drop frames the ring has already wrapped onto:
+    while (_count > 0 and (received - _frames[_tail].start) > RING_SIZE) {
+        _tail = (_tail + 1) % MAX_FRAMES;
+        _count--;
+        _overruns++;
+    }
+    if (_count == 0) {
+        spin_unlock(_lock, irqState);
+        return ERROR_NO_FRAME;
+    }
+    const __frameDesc__ desc = _frames[_tail];
+    spin_unlock(_lock, irqState);
+    const uint32_t offset = desc.start & _RING_MASK;
+    const uint32_t firstLength = MIN(desc.length, RING_SIZE - offset);
+    frame.data = &_ring[offset];
+    frame.length = firstLength;
+    frame.wrapData = (desc.length > firstLength) ? _ring : nullptr;
+    frame.wrapLength = desc.length - firstLength;
+    return NO_ERROR;
+}
+
+int16_t mySPISlave::releaseFrame() {
+    if (_initialized == false) { return ERROR_NOT_INITIALIZED; }
+    uint32_t irqState = spin_lock_blocking(_lock);
+    if (_count == 0) {
+        spin_unlock(_lock, irqState);
+        return ERROR_NO_FRAME;
+    }
+    const bool overwritten = ((__received__() - _frames[_tail].start) > RING_SIZE);
+    _tail = (_tail + 1) % MAX_FRAMES;
+    _count--;
+    if (overwritten == true) { _overruns++; }
+    spin_unlock(_lock, irqState);
+    if (overwritten == true) { return ERROR_OVERRUN; }
+    return NO_ERROR;
+}
+
+uint32_t mySPISlave::getOverruns() {
+    return _overruns;
+}
+
+/* ################## Private functions: ################# */
+void mySPISlave::__csIrqHandler__() {
+    for (uint8_t i=0; i<MY_SPI_NUM_PORTS; i++) {
+        mySPISlave *slave = _instances[i];
+        if (slave == nullptr) { continue; }
+        if (gpio_get_irq_event_mask(slave->_csPin) & GPIO_IRQ_EDGE_RISE) {
+            gpio_acknowledge_irq(slave->_csPin, GPIO_IRQ_EDGE_RISE);
+            slave->__frameEnd__();
+        }
+    }
+}
+
+uint32_t mySPISlave::__received__() {
+    return _rxBase + (_ARM_COUNT - dma_hw->ch[_rxChannel].transfer_count);
+}
+
+void mySPISlave::__armRx__(const uint32_t received) {
+    dma_channel_abort(_rxChannel);
+    dma_channel_config rxConfig = dma_channel_get_default_config(_rxChannel);
+    channel_config_set_transfer_data_size(&rxConfig, DMA_SIZE_8);
+    channel_config_set_read_increment(&rxConfig, false);
+    channel_config_set_write_increment(&rxConfig, true);
+    channel_config_set_ring(&rxConfig, true, MY_SPI_SLAVE_RING_BITS);
+    channel_config_set_dreq(&rxConfig, spi_get_dreq(_spiPort, false));
+    _rxBase = received;
+    dma_channel_configure(_rxChannel, &rxConfig, &_ring[received & _RING_MASK], &spi_get_hw(_spiPort)->dr,
+                            _ARM_COUNT, true);
+}
+
+void mySPISlave::__startTx__(const uint8_t *src, const size_t len) {
+    dma_channel_config txConfig = dma_channel_get_default_config(_txChannel);
+    channel_config_set_transfer_data_size(&txConfig, DMA_SIZE_8);
+    channel_config_set_read_increment(&txConfig, true);
+    channel_config_set_write_increment(&txConfig, false);
+    channel_config_set_dreq(&txConfig, spi_get_dreq(_spiPort, true));
+    dma_channel_configure(_txChannel, &txConfig, &spi_get_hw(_spiPort)->dr, src, len, true);
+}
+
+void mySPISlave::__frameEnd__() {
+// Let the DMA drain the rx FIFO, so the count covers the whole frame:
+    while (spi_is_readable(_spiPort) == true) { tight_loop_contents(); }
+    uint32_t irqState = spin_lock_blocking(_lock);
+    const uint32_t received = __received__();
+    const uint32_t length = received - _frameStart;
+    if (length > RING_SIZE) {
+        _overruns++;                                            // Frame longer than the ring.
+    } else if (length > 0) {
+        if (_count == MAX_FRAMES) {                             // Drop the oldest.
+            _tail = (_tail + 1) % MAX_FRAMES;
+            _count--;
+            _overruns++;
+        }
+        _frames[_head].start = _frameStart;
+        _frames[_head].length = length;
+        _head = (_head + 1) % MAX_FRAMES;
+        _count++;
+    }
+    _frameStart = received;
+// The bus is idle between frames, re-arm before the transfer count runs out:
+    if (dma_hw->ch[_rxChannel].transfer_count < (_ARM_COUNT / 2)) { __armRx__(received); }
+// A short frame leaves the tx channel running, stop it, and load the next buffer:
+    if (dma_channel_is_busy(_txChannel) == true) { dma_channel_abort(_txChannel); }
+    if (_txPending != nullptr) {
+        __startTx__(_txPending, _txPendingLen);
+        _txPending = nullptr;
+    }
+    spin_unlock(_lock, irqState);
+}
+#endif
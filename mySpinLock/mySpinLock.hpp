@@ -113,6 +113,14 @@ class mySpinLock {
          * @return int16_t Lock number.
          */
         int16_t getLockNum();
+        /**
+         * @brief Release a lock number.
+         * Unclaims the lock, so a later GENERATE_LOCK_NUM can hand it out again. Call once the
+         * last instance using it is done with it.
+         * @param lockNum Lock number to release.
+         * @return int16_t Return 0 (NO_ERROR) if released okay, negative for error code.
+         */
+        static int16_t release(const int16_t lockNum);
 
     private:
 /* ############### Private Variables: #################### */
@@ -176,6 +184,15 @@ int16_t mySpinLock::isLocked() {
 int16_t mySpinLock::getLockNum() {
     return _lockNum;
 }
+
+int16_t mySpinLock::release(const int16_t lockNum) {
+    if (lockNum < 0 or lockNum >= NUM_SPIN_LOCKS) { return ERROR_INVALID_LOCK_NUM; }
+    if (__getClaimed__(lockNum) == false) { return ERROR_NOT_CLAIMED; }
+    spin_lock_unclaim(lockNum);
+    __setClaimed__(lockNum, false);
+    __setInit__(lockNum, false);
+    return NO_ERROR;
+}
 /* ################# Private Functions: ##################### */
 
 void mySpinLock::__setInit__(const int16_t lockNum, const bool value) {
@@ -156,6 +156,46 @@
      * @note Some pins on SPI port 1 only have 3 options.
      */
     #define MY_SPI_NUM_PINS 4
+    #ifndef MY_SPI_DMA_CHUNK_SIZE
+        /**
+         * @brief Size of a SPI DMA staging chunk.
+         * Number of bytes reversed and sent per DMA transfer by the LSB first transfer functions. Two
+         * buffers of this size are kept per port. Define before including to override.
+         */
+        #define MY_SPI_DMA_CHUNK_SIZE 256
+    #endif
+    #ifndef MY_SPI_QUEUE_LENGTH
+        /**
+         * @brief Length of a SPI transaction queue.
+         * Number of transactions a mySPIQueue can hold, including the one in progress. Define before
+         * including to override.
+         */
+        #define MY_SPI_QUEUE_LENGTH 8
+    #endif
+    #ifndef MY_SPI_MAX_PROFILES
+        /**
+         * @brief Number of SPI device profiles.
+         * Number of device profiles that can be registered across both SPI ports. Define before
+         * including to override.
+         */
+        #define MY_SPI_MAX_PROFILES 8
+    #endif
+    #ifndef MY_SPI_SLAVE_RING_BITS
+        /**
+         * @brief Size of the SPI slave receive ring, as a power of 2.
+         * The ring is (1 << MY_SPI_SLAVE_RING_BITS) bytes, and aligned to its size as the DMA ring
+         * wrap requires. Must be 15 or less. Define before including to override.
+         */
+        #define MY_SPI_SLAVE_RING_BITS 10
+    #endif
+    #ifndef MY_SPI_SLAVE_MAX_FRAMES
+        /**
+         * @brief Number of SPI slave frames.
+         * Number of completed frames a mySPISlave can hold before the oldest is dropped. Define
+         * before including to override.
+         */
+        #define MY_SPI_SLAVE_MAX_FRAMES 8
+    #endif
 /*
  * ################################ I2C Defines: ###################################
  */
@@ -179,6 +219,83 @@
      * Total number of spinlocks on the rp2040.
      */
     #define MY_NUM_SPIN_LOCKS 32
+/*
+ * ########################### 23LC1024 Defines: ##########################
+ */
+    #ifndef MY_23LC1024_CACHE_LINES
+        /**
+         * @brief Number of 23LC1024 cache lines.
+         * Number of 32 byte lines a my23LC1024Cache keeps in RAM. Define before including to
+         * override.
+         */
+        #define MY_23LC1024_CACHE_LINES 16
+    #endif
+    #ifndef MY_23LC1024_HEAP_HANDLES
+        /**
+         * @brief Number of 23LC1024 heap handles.
+         * Most blocks a my23LC1024Heap can have allocated at once. Define before including to
+         * override.
+         */
+        #define MY_23LC1024_HEAP_HANDLES 32
+    #endif
+    #ifndef MY_23LC1024_FIFO_STAGE_SIZE
+        /**
+         * @brief Size of the 23LC1024 FIFO staging buffers.
+         * Bytes a my23LC1024FIFO batches in RAM on each side before a burst to or from the sram.
+         * Define before including to override.
+         */
+        #define MY_23LC1024_FIFO_STAGE_SIZE 256
+    #endif
+    #ifndef MY_23LC1024_ARRAY_MAX_CHIPS
+        /**
+         * @brief Most chips in a 23LC1024 array, 1 to 8.
+         * Define before including to override.
+         */
+        #define MY_23LC1024_ARRAY_MAX_CHIPS 4
+    #endif
+    #ifndef MY_23LC1024_STRIPE_SIZE
+        /**
+         * @brief Default 23LC1024 array stripe size.
+         * Consecutive bytes a my23LC1024Array puts on one chip before moving to the next. Define
+         * before including to override.
+         */
+        #define MY_23LC1024_STRIPE_SIZE 512
+    #endif
+    #ifndef MY_23LC1024_BATCH_MAX_OPS
+        /**
+         * @brief Most operations in a 23LC1024 batch.
+         * Define before including to override.
+         */
+        #define MY_23LC1024_BATCH_MAX_OPS 32
+    #endif
+    #ifndef MY_23LC1024_EXT_WINDOW_SIZE
+        /**
+         * @brief Size of a 23LC1024 external array iterator window.
+         * Bytes a my23LC1024ExtArray iterator prefetches per burst. Define before including to
+         * override.
+         */
+        #define MY_23LC1024_EXT_WINDOW_SIZE 256
+    #endif
+/*
+ * ########################### 25xx640A Defines: ##########################
+ */
+    #ifndef MY_25XX640A_POLL_US
+        /**
+         * @brief 25xx640A background write poll interval.
+         * Microseconds between status polls of a my25xx640A::writePageAsync() write cycle, by its
+         * poll timer, or at least between isWriteBusy() polls without one. Define before including
+         * to override.
+         */
+        #define MY_25XX640A_POLL_US 250
+    #endif
+    #ifndef MY_25XX640A_LOG_MAX_KEYS
+        /**
+         * @brief Number of 25xx640A log keys.
+         * Keys a my25xx640ALog indexes in RAM, keys run from 0 to one less than this, at most 255.
+         * Define before including to override.
+         */
+        #define MY_25XX640A_LOG_MAX_KEYS 32
+    #endif
 
 /* 
  * ############################## Error Defines: ####################################
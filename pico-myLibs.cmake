@@ -13,4 +13,6 @@ add_subdirectory("/home/streak/pico/pico-myLibs/myAT24C32/" "/home/streak/pico/p
 add_subdirectory("/home/streak/pico/pico-myLibs/myMCP49x2/" "/home/streak/pico/pico-myLibs/myMCP49x2/")
 # add_subdirectory("/home/streak/pico/pico-myLibs/myNRF2401/" "/home/streak/pico/pico-myLibs/myNRF2401/")
 add_subdirectory("/home/streak/pico/pico-myLibs/myMAX1415" "/home/streak/pico/pico-myLibs/myMAX1415")
-add_subdirectory("/home/streak/pico/pico-myLibs/my25xx640A" "/home/streak/pico/pico-myLibs/my25xx640A")
\ No newline at end of file
+add_subdirectory("/home/streak/pico/pico-myLibs/my25xx640A" "/home/streak/pico/pico-myLibs/my25xx640A")
+add_subdirectory("/home/streak/pico/pico-myLibs/mySPIQueue" "/home/streak/pico/pico-myLibs/mySPIQueue")
+add_subdirectory("/home/streak/pico/pico-myLibs/mySPISlave" "/home/streak/pico/pico-myLibs/mySPISlave")
\ No newline at end of file